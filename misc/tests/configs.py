@@ -18,9 +18,24 @@ def configs_optimal_core():
         "astar_lmcut": [
             "--search",
             "astar(lmcut())"],
+        "astar_lmcut_incremental": [
+            "--search",
+            "astar(lmcut(max_cached_states=infinity))"],
+        "astar_lmcut_flat": [
+            "--search",
+            "astar(lmcut(implementation=flat))"],
+        "astar_lmcut_parallel_evaluation": [
+            "--search",
+            "astar(lmcut(), threads=2)"],
+        "hdastar_lmcut": [
+            "--search",
+            "hdastar(lmcut(), threads=2)"],
         "astar_hmax": [
             "--search",
             "astar(hmax())"],
+        "astar_lmcut_large_values": [
+            "--search",
+            "astar(weight(lmcut(), 100000))"],
         "astar_merge_and_shrink_rl_fh": [
             "--search",
             "astar(merge_and_shrink("
@@ -91,6 +106,9 @@ def configs_satisficing_core():
         "lazy_greedy_cg": [
             "--search",
             "let(h,cg(),lazy_greedy([h],preferred=[h]))"],
+        "lazy_greedy_goalcount_batch_evaluation": [
+            "--search",
+            "lazy_greedy([goalcount()], batch_evaluation=true)"],
         # LAMA first
         "lama-first": [
             "--search",
@@ -117,6 +135,22 @@ def configs_optimal_extended():
         "pdb": [
             "--search",
             "astar(pdb())"],
+        "zopdbs_parallel": [
+            "--search",
+            "astar(zopdbs(systematic(2), threads=2))"],
+        "astar_lmcut_without_parents": [
+            "--search",
+            "astar(lmcut(), store_parents=false)"],
+        "astar_blind_without_parents": [
+            "--search",
+            "astar(blind(), store_parents=false)"],
+        "astar_blind_flat_successor_generator": [
+            "--search",
+            "astar(blind(), successor_generator=flat)"],
+        "pdbs_batch_evaluation": [
+            "--search",
+            "astar(max([pdb(), cpdbs(systematic(2)), zopdbs(systematic(2)),"
+            "blind()]), batch_evaluation=true)"],
     }
 
 
@@ -139,6 +173,10 @@ def configs_satisficing_extended():
         "lazy_greedy_cea": [
             "--search",
             "let(h,cea(),lazy_greedy([h],preferred=[h]))"],
+        "lazy_greedy_ff_flattened_unit_cost": [
+            "--search",
+            "let(h,eval_modify_costs(eval_flatten_task(ff()),cost_type=one),"
+            "lazy_greedy([h],preferred=[h]))"],
         # lazy wA*
         "lazy_wa3_ff": [
             "--search",
@@ -156,6 +194,22 @@ def configs_satisficing_extended():
             "--search",
             "let(h,ff(),iterated([lazy_wastar([h],w=10), lazy_wastar([h],w=5), lazy_wastar([h],w=3),"
             "lazy_wastar([h],w=2), lazy_wastar([h],w=1)]))"],
+        "iterated_wa_ff_bound_hmax": [
+            "--search",
+            "let(h,ff(),let(hb,hmax(),iterated([lazy_greedy([h],preferred=[h]),"
+            "lazy_wastar([h],w=2,preferred=[h],bound_evaluator=hb),"
+            "eager_wastar([h],w=1,preferred=[h],bound_evaluator=hb)])))"],
+        "iterated_wa_ff_bound_hmax_evaluate_in_advance": [
+            "--search",
+            "let(h,ff(),let(hb,hmax(),iterated([lazy_greedy([h]),"
+            "eager_wastar([h],w=2,bound_evaluator=hb,threads=2),"
+            "eager_wastar([h],w=1,bound_evaluator=hb,batch_evaluation=true)])))"],
+        # parallel portfolio
+        "portfolio_ff_cg": [
+            "--search",
+            "portfolio([lazy_greedy([ff()]), eager_greedy([cg()]),"
+            "iterated([lazy_wastar([ff()],w=5), lazy_wastar([ff()],w=1)])],"
+            "continue_on_solve=true)"],
         # pareto open list
         "pareto_ff": [
             "--search",
@@ -168,6 +222,9 @@ def configs_optimal_lp(lp_solver="cplex"):
     return {
         "divpot": ["--search", f"astar(diverse_potentials(lpsolver={lp_solver}))"],
         "seq+lmcut": ["--search", f"astar(operatorcounting([state_equation_constraints(), lmcut_constraints()], lpsolver={lp_solver}))"],
+        "potentials_batch_evaluation": ["--search", f"astar(max([initial_state_potential(lpsolver={lp_solver}), diverse_potentials(lpsolver={lp_solver})]), batch_evaluation=true)"],
+        "lazy_greedy_potential_batch_evaluation": ["--search", f"lazy_greedy([sample_based_potentials(lpsolver={lp_solver})], batch_evaluation=true)"],
+        "seq+lmcut_warm_start": ["--search", f"astar(operatorcounting([state_equation_constraints(), lmcut_constraints()], max_cached_bases=1000, lpsolver={lp_solver}))"],
     }
 
 
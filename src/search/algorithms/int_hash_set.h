@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -32,8 +33,8 @@ namespace int_hash_set {
 
   Limitations:
 
-  We use 32-bit (signed and unsigned) integers instead of larger data
-  types for keys and hashes to save memory.
+  By default, we use 32-bit (signed and unsigned) integers instead of
+  larger data types for keys and hashes to save memory.
 
   Consequently, the range of valid keys is [0, 2^31 - 1]. This range
   could be extended to [0, 2^32 - 2] without using more memory by
@@ -43,8 +44,12 @@ namespace int_hash_set {
   The maximum capacity (i.e., number of buckets) is 2^30 because we
   use a signed integer to store it, we grow the hash set by doubling
   its capacity, and the next larger power of 2 (2^31) is too big for
-  an int. The maximum capacity could be increased by storing the
-  number of buckets in a larger data type.
+  an int.
+
+  Since the keys are usually state IDs, building with
+  USE_64BIT_STATE_IDS switches to 64-bit keys, hashes and bucket
+  indices. This lifts both limits (the maximum capacity becomes 2^62)
+  but doubles the size of a bucket to 16 bytes.
 
   Note on hash functions:
 
@@ -67,20 +72,54 @@ namespace int_hash_set {
   check for a given key are aligned in memory, the lookup has good
   cache locality.
 
+  Each bucket stores the full hash of its key, which serves as a
+  fingerprint: we only call the equality tester (which usually has to
+  look up data stored elsewhere, e.g., the state data in a state
+  registry) for keys with exactly the same hash. Such comparisons
+  either confirm a duplicate or are caused by a hash collision.
+  print_statistics() reports how many comparisons failed, i.e., how
+  many lookups of external data a wider fingerprint could have
+  avoided.
+
 */
 
+#ifdef USE_64BIT_STATE_IDS
+using KeyType = std::int64_t;
+using HashType = std::uint64_t;
+// Type for bucket indices and numbers of entries.
+using IndexType = std::int64_t;
+#else
 using KeyType = int;
 using HashType = unsigned int;
+using IndexType = int;
+#endif
 
-static_assert(sizeof(KeyType) == 4, "KeyType does not use 4 bytes");
-static_assert(sizeof(HashType) == 4, "HashType does not use 4 bytes");
+static_assert(
+    sizeof(KeyType) == sizeof(HashType),
+    "KeyType and HashType do not have the same size");
+static_assert(
+    sizeof(IndexType) == sizeof(KeyType),
+    "IndexType and KeyType do not have the same size");
+
+/*
+  Map a hash value to one of num_partitions partitions (e.g., shards or
+  threads). IntHashSet uses the lower bits of the hash to select buckets,
+  so we use the upper 32 bits here. Otherwise, the keys of each partition
+  would only use a fraction of the buckets of a hash set.
+*/
+inline int get_partition(HashType hash, int num_partitions) {
+    assert(num_partitions > 0);
+    const int hash_bits = std::numeric_limits<HashType>::digits;
+    std::uint64_t upper_bits =
+        static_cast<std::uint64_t>(hash) >> (hash_bits - 32);
+    return static_cast<int>((upper_bits * num_partitions) >> 32);
+}
 
 template<typename Hasher, typename Equal>
 class IntHashSet {
     // Max distance from the ideal bucket to the actual bucket for each key.
     static const int MAX_DISTANCE = 32;
-    static const unsigned int MAX_BUCKETS =
-        std::numeric_limits<unsigned int>::max();
+    static const IndexType MAX_BUCKETS = std::numeric_limits<IndexType>::max();
 
     struct Bucket {
         KeyType key;
@@ -102,16 +141,19 @@ class IntHashSet {
     Hasher hasher;
     Equal equal;
     std::vector<Bucket> buckets;
-    int num_entries;
+    IndexType num_entries;
     int num_resizes;
+    // Number of calls to the equality tester and how many of them failed.
+    mutable int64_t num_key_comparisons;
+    mutable int64_t num_failed_key_comparisons;
 
-    int capacity() const {
+    IndexType capacity() const {
         return buckets.size();
     }
 
-    void rehash(int new_capacity) {
+    void rehash(IndexType new_capacity) {
         assert(new_capacity >= 1);
-        int num_entries_before = num_entries;
+        IndexType num_entries_before = num_entries;
         std::vector<Bucket> old_buckets = std::move(buckets);
         assert(buckets.empty());
         num_entries = 0;
@@ -127,7 +169,7 @@ class IntHashSet {
     }
 
     void enlarge() {
-        unsigned int num_buckets = buckets.size();
+        IndexType num_buckets = capacity();
         // Verify that the number of buckets is a power of 2.
         assert((num_buckets & (num_buckets - 1)) == 0);
         if (num_buckets > MAX_BUCKETS / 2) {
@@ -142,9 +184,9 @@ class IntHashSet {
         rehash(num_buckets * 2);
     }
 
-    int get_bucket(HashType hash) const {
+    IndexType get_bucket(HashType hash) const {
         assert(!buckets.empty());
-        unsigned int num_buckets = buckets.size();
+        HashType num_buckets = buckets.size();
         // Verify that the number of buckets is a power of 2.
         assert((num_buckets & (num_buckets - 1)) == 0);
         /* We want to return hash % num_buckets. The following line does this
@@ -156,7 +198,7 @@ class IntHashSet {
       Return distance from index1 to index2, only moving right and wrapping
       from the last to the first bucket.
     */
-    int get_distance(int index1, int index2) const {
+    IndexType get_distance(IndexType index1, IndexType index2) const {
         assert(utils::in_bounds(index1, buckets));
         assert(utils::in_bounds(index2, buckets));
         if (index2 >= index1) {
@@ -166,7 +208,7 @@ class IntHashSet {
         }
     }
 
-    int find_next_free_bucket_index(int index) const {
+    IndexType find_next_free_bucket_index(IndexType index) const {
         assert(num_entries < capacity());
         assert(utils::in_bounds(index, buckets));
         while (buckets[index].full()) {
@@ -177,13 +219,16 @@ class IntHashSet {
 
     KeyType find_equal_key(KeyType key, HashType hash) const {
         assert(hasher(key) == hash);
-        int ideal_index = get_bucket(hash);
+        IndexType ideal_index = get_bucket(hash);
         for (int i = 0; i < MAX_DISTANCE; ++i) {
-            int index = get_bucket(ideal_index + i);
+            IndexType index = get_bucket(ideal_index + i);
             const Bucket &bucket = buckets[index];
-            if (bucket.full() && bucket.hash == hash &&
-                equal(bucket.key, key)) {
-                return bucket.key;
+            if (bucket.full() && bucket.hash == hash) {
+                ++num_key_comparisons;
+                if (equal(bucket.key, key)) {
+                    return bucket.key;
+                }
+                ++num_failed_key_comparisons;
             }
         }
         return Bucket::empty_bucket_key;
@@ -220,10 +265,10 @@ class IntHashSet {
         assert(num_entries < capacity());
 
         // Compute ideal bucket.
-        int ideal_index = get_bucket(hash);
+        IndexType ideal_index = get_bucket(hash);
 
         // Find first free bucket left of the ideal bucket.
-        int free_index = find_next_free_bucket_index(ideal_index);
+        IndexType free_index = find_next_free_bucket_index(ideal_index);
 
         /*
           While the free bucket is too far from the ideal bucket, move the free
@@ -234,15 +279,16 @@ class IntHashSet {
         */
         while (get_distance(ideal_index, free_index) >= MAX_DISTANCE) {
             bool swapped = false;
-            int num_buckets = capacity();
-            int max_offset = std::min(MAX_DISTANCE, num_buckets) - 1;
+            IndexType num_buckets = capacity();
+            int max_offset = static_cast<int>(
+                std::min<IndexType>(MAX_DISTANCE, num_buckets) - 1);
             for (int offset = max_offset; offset >= 1; --offset) {
                 assert(offset < num_buckets);
-                int candidate_index = free_index + num_buckets - offset;
+                IndexType candidate_index = free_index + num_buckets - offset;
                 assert(candidate_index >= 0);
                 candidate_index = get_bucket(candidate_index);
                 HashType candidate_hash = buckets[candidate_index].hash;
-                int candidate_ideal_index = get_bucket(candidate_hash);
+                IndexType candidate_ideal_index = get_bucket(candidate_hash);
                 if (get_distance(candidate_ideal_index, free_index) <
                     MAX_DISTANCE) {
                     // Candidate can be swapped.
@@ -272,13 +318,23 @@ public:
           equal(equal),
           buckets(1),
           num_entries(0),
-          num_resizes(0) {
+          num_resizes(0),
+          num_key_comparisons(0),
+          num_failed_key_comparisons(0) {
     }
 
-    int size() const {
+    IndexType size() const {
         return num_entries;
     }
 
+    /*
+      Return the number of bytes allocated for buckets. Dividing by size()
+      gives the memory used for duplicate detection per key.
+    */
+    std::size_t get_allocated_bytes() const {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+
     /*
       Insert a key into the hash set.
 
@@ -291,10 +347,18 @@ public:
         return insert(key, hasher(key));
     }
 
+    /*
+      Return the given key or an equivalent key contained in the hash set, or
+      -1 if the hash set contains no such key.
+    */
+    KeyType find(KeyType key) const {
+        return find_equal_key(key, hasher(key));
+    }
+
     void dump(utils::LogProxy &log) const {
-        int num_buckets = capacity();
+        IndexType num_buckets = capacity();
         log << "[";
-        for (int i = 0; i < num_buckets; ++i) {
+        for (IndexType i = 0; i < num_buckets; ++i) {
             const Bucket &bucket = buckets[i];
             if (bucket.full()) {
                 log << bucket.key;
@@ -310,12 +374,16 @@ public:
 
     void print_statistics(utils::LogProxy &log) const {
         assert(!buckets.empty());
-        int num_buckets = capacity();
+        IndexType num_buckets = capacity();
         assert(num_buckets != 0);
         log << "Int hash set load factor: " << num_entries << "/" << num_buckets
             << " = " << static_cast<double>(num_entries) / num_buckets
             << std::endl;
         log << "Int hash set resizes: " << num_resizes << std::endl;
+        log << "Int hash set key comparisons: " << num_key_comparisons
+            << std::endl;
+        log << "Int hash set failed key comparisons: "
+            << num_failed_key_comparisons << std::endl;
     }
 };
 
@@ -323,7 +391,7 @@ template<typename Hasher, typename Equal>
 const int IntHashSet<Hasher, Equal>::MAX_DISTANCE;
 
 template<typename Hasher, typename Equal>
-const unsigned int IntHashSet<Hasher, Equal>::MAX_BUCKETS;
+const IndexType IntHashSet<Hasher, Equal>::MAX_BUCKETS;
 }
 
 #endif
@@ -64,6 +64,18 @@ public:
         Bin &bin = buffer[bin_index];
         bin = (bin & clear_mask) | (value << shift);
     }
+
+    int get_bin_index() const {
+        return bin_index;
+    }
+
+    int get_shift() const {
+        return shift;
+    }
+
+    Bin get_read_mask() const {
+        return read_mask;
+    }
 };
 
 IntPacker::IntPacker(const vector<int> &ranges) : num_bins(0) {
@@ -81,6 +93,18 @@ void IntPacker::set(Bin *buffer, int var, int value) const {
     var_infos[var].set(buffer, value);
 }
 
+int IntPacker::get_bin_index(int var) const {
+    return var_infos[var].get_bin_index();
+}
+
+int IntPacker::get_shift(int var) const {
+    return var_infos[var].get_shift();
+}
+
+IntPacker::Bin IntPacker::get_read_mask(int var) const {
+    return var_infos[var].get_read_mask();
+}
+
 void IntPacker::pack_bins(const vector<int> &ranges) {
     assert(var_infos.empty());
 
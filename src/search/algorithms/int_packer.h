@@ -43,6 +43,15 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      Describe where a variable is stored: its value is
+      (buffer[get_bin_index(var)] & get_read_mask(var)) >> get_shift(var).
+      This allows to read many variables without calling get() for each.
+    */
+    int get_bin_index(int var) const;
+    int get_shift(int var) const;
+    Bin get_read_mask(int var) const;
+
     int get_num_bins() const {
         return num_bins;
     }
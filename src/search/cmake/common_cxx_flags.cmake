@@ -18,6 +18,11 @@ target_compile_options(common_cxx_flags INTERFACE
     "$<${using_gcc_like_release}:-DNDEBUG;-fomit-frame-pointer>")
 target_compile_definitions(common_cxx_flags INTERFACE
     "$<${should_use_glibcxx_debug}:_GLIBCXX_DEBUG>")
+target_compile_definitions(common_cxx_flags INTERFACE
+    "$<$<BOOL:${USE_64BIT_STATE_IDS}>:USE_64BIT_STATE_IDS>")
+set(should_use_native_arch "$<AND:${using_gcc_like},$<BOOL:${USE_NATIVE_ARCH}>>")
+target_compile_options(common_cxx_flags INTERFACE
+    "$<${should_use_native_arch}:-march=native>")
 # Enable exceptions for MSVC.
 target_compile_options(common_cxx_flags INTERFACE
     "$<${using_msvc}:/EHsc>")
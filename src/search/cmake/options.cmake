@@ -27,6 +27,21 @@ option USE_LP to false."
             "not supported when an LP solver is used. See issue982 for details.")
     endif()
 
+    option(
+        USE_64BIT_STATE_IDS
+        "Use 64-bit integers for state IDs and for the hash sets of state \
+registries. This allows to register more than 2^30 states per registry, but \
+increases the memory usage per state by 8 bytes for duplicate detection and \
+by 4 bytes for each stored state ID (e.g., in search nodes and open lists)."
+        FALSE)
+
+    option(
+        USE_NATIVE_ARCH
+        "Optimize for the instruction set of the machine that compiles the \
+planner (-march=native). This enables SIMD code paths, e.g. for evaluating \
+potential heuristics, but the binary might not run on other machines."
+        FALSE)
+
     option(
         DISABLE_LIBRARIES_BY_DEFAULT
         "If set to YES only libraries that are specifically enabled will be compiled"
@@ -144,6 +144,9 @@ static ParsedSearchOptions parse_cmd_line_aux(const vector<string> &args) {
             }
             cout << "Help output finished." << endl;
             exit(0);
+        } else if (arg == "--binary-task" || arg == "--write-binary-task") {
+            // Handled by parse_task_input_options.
+            ++i;
         } else if (arg == "--internal-plan-file") {
             if (is_last)
                 input_error("missing argument after --internal-plan-file");
@@ -167,6 +170,30 @@ static ParsedSearchOptions parse_cmd_line_aux(const vector<string> &args) {
     return parsed_options;
 }
 
+TaskInputOptions parse_task_input_options(int argc, const char **argv) {
+    TaskInputOptions options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool is_last = (i == argc - 1);
+        if (arg == "--binary-task" || arg == "--write-binary-task") {
+            if (is_last)
+                input_error("missing argument after " + arg);
+            ++i;
+            if (arg == "--binary-task") {
+                options.binary_task_filename = argv[i];
+            } else {
+                options.binary_task_output_filename = argv[i];
+            }
+        }
+    }
+    if (!options.binary_task_filename.empty() &&
+        !options.binary_task_output_filename.empty()) {
+        input_error(
+            "--binary-task and --write-binary-task cannot be used together");
+    }
+    return options;
+}
+
 ParsedSearchOptions parse_cmd_line(
     int argc, const char **argv, bool is_unit_cost) {
     vector<string> args;
@@ -203,6 +230,12 @@ string get_usage(const string &progname) {
            "    Without parameter: print help for everything available\n"
            "--internal-git-revision\n"
            "    Print the revision of the code used to build this binary.\n"
+           "--binary-task FILENAME\n"
+           "    Read the task from a binary task file instead of OUTPUT.\n"
+           "--write-binary-task FILENAME\n"
+           "    Convert OUTPUT to a binary task file called FILENAME and exit\n"
+           "    (no search is run). Also reports the time for reading both\n"
+           "    formats.\n"
            "--internal-plan-file FILENAME\n"
            "    Output the plan to a file called FILENAME\n\n"
            "--internal-previous-portfolio-plans COUNTER\n"
@@ -13,6 +13,19 @@ struct ParsedSearchOptions {
     bool is_part_of_anytime_portfolio;
 };
 
+struct TaskInputOptions {
+    // Read the task from this binary task file instead of the standard input.
+    std::string binary_task_filename;
+    // Only convert the task from the standard input to this binary task file.
+    std::string binary_task_output_filename;
+};
+
+/*
+  The options that determine how the task is read have to be known before
+  the task is read, and hence before the other options can be parsed.
+*/
+extern TaskInputOptions parse_task_input_options(int argc, const char **argv);
+
 extern ParsedSearchOptions parse_cmd_line(
     int argc, const char **argv, bool is_unit_cost);
 
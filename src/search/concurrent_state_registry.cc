@@ -0,0 +1,275 @@
+#include "concurrent_state_registry.h"
+
+#include "axioms.h"
+
+#include "task_utils/task_properties.h"
+#include "utils/collections.h"
+#include "utils/logging.h"
+#include "utils/system.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+/*
+  IDs must be smaller than CANDIDATE_KEY, so we can use the largest key
+  supported by IntHashSet.
+*/
+const int_hash_set::KeyType ConcurrentStateRegistry::CANDIDATE_KEY =
+    numeric_limits<int_hash_set::KeyType>::max();
+
+/*
+  Segments of the state pool have roughly 2^SEGMENT_BYTES_LOG bytes, unless
+  states are so large that this would require more than
+  2^(MAX_POOL_BYTES_LOG - SEGMENT_BYTES_LOG) segment pointers. We allocate
+  all segment pointers upfront, so with 64-bit state IDs we limit the pool to
+  2^MAX_POOL_BYTES_LOG bytes of state data instead of limiting it by the
+  largest ID.
+*/
+static const int SEGMENT_BYTES_LOG = 21;
+static const int MIN_STATES_PER_SEGMENT_LOG = 10;
+static const int MAX_POOL_BYTES_LOG = 42;
+
+static int compute_states_per_segment_log(int num_bins) {
+    int bytes_per_state = num_bins * sizeof(PackedStateBin);
+    int log = SEGMENT_BYTES_LOG;
+    while (log > MIN_STATES_PER_SEGMENT_LOG &&
+           (1 << (SEGMENT_BYTES_LOG - log)) < bytes_per_state) {
+        --log;
+    }
+    return log;
+}
+
+static int_hash_set::KeyType compute_max_num_states(int num_bins) {
+    int64_t max_num_states =
+        (int64_t(1) << MAX_POOL_BYTES_LOG) / (num_bins * sizeof(PackedStateBin));
+    // IDs must be smaller than CANDIDATE_KEY.
+    return static_cast<int_hash_set::KeyType>(min<int64_t>(
+        max_num_states, numeric_limits<int_hash_set::KeyType>::max()));
+}
+
+static int round_up_to_power_of_two(int value) {
+    int result = 1;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+int_hash_set::HashType ConcurrentStateRegistry::ShardHash::operator()(
+    int_hash_set::KeyType key) const {
+    if (key == CANDIDATE_KEY) {
+        return shard.candidate_hash;
+    }
+    return registry.kernels.hash(registry.get_buffer(key), registry.num_bins);
+}
+
+bool ConcurrentStateRegistry::ShardEqual::operator()(
+    int_hash_set::KeyType lhs, int_hash_set::KeyType rhs) const {
+    const PackedStateBin *lhs_data = lhs == CANDIDATE_KEY
+                                         ? shard.candidate_buffer
+                                         : registry.get_buffer(lhs);
+    const PackedStateBin *rhs_data = rhs == CANDIDATE_KEY
+                                         ? shard.candidate_buffer
+                                         : registry.get_buffer(rhs);
+    return registry.kernels.equal(lhs_data, rhs_data, registry.num_bins);
+}
+
+ConcurrentStateRegistry::Shard::Shard(const ConcurrentStateRegistry &registry)
+    : candidate_buffer(nullptr),
+      candidate_hash(0),
+      registered_states(
+          ShardHash(registry, *this), ShardEqual(registry, *this)) {
+}
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const TaskProxy &task_proxy, int num_threads, int num_shards)
+    : task_proxy(task_proxy),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      num_bins(state_packer.get_num_bins()),
+      kernels(get_state_data_kernels(num_bins)),
+      has_axioms(task_properties::has_axioms(task_proxy)),
+      states_per_segment_log(compute_states_per_segment_log(num_bins)),
+      max_num_states(compute_max_num_states(num_bins)),
+      segments((max_num_states >> states_per_segment_log) + 1),
+      num_states(0),
+      thread_data(num_threads) {
+    assert(num_threads >= 1);
+    assert(num_shards >= 1);
+    num_shards = round_up_to_power_of_two(num_shards);
+    shards.reserve(num_shards);
+    for (int i = 0; i < num_shards; ++i) {
+        shards.push_back(make_unique<Shard>(*this));
+    }
+    for (ThreadData &data : thread_data) {
+        data.buffer.resize(num_bins);
+        if (has_axioms) {
+            data.values.resize(task_proxy.get_variables().size());
+            data.axiom_evaluator = make_unique<AxiomEvaluator>(task_proxy);
+        }
+    }
+}
+
+ConcurrentStateRegistry::~ConcurrentStateRegistry() {
+    for (atomic<PackedStateBin *> &segment : segments) {
+        delete[] segment.load(memory_order_relaxed);
+    }
+}
+
+const PackedStateBin *ConcurrentStateRegistry::get_buffer(
+    int_hash_set::KeyType index) const {
+    assert(index >= 0 && index < size());
+    const PackedStateBin *segment =
+        segments[index >> states_per_segment_log].load(memory_order_acquire);
+    assert(segment);
+    int offset = static_cast<int>(index & ((1 << states_per_segment_log) - 1));
+    return segment + static_cast<size_t>(offset) * num_bins;
+}
+
+PackedStateBin *ConcurrentStateRegistry::get_or_create_segment(
+    int segment_index) {
+    atomic<PackedStateBin *> &segment = segments[segment_index];
+    PackedStateBin *existing_segment = segment.load(memory_order_acquire);
+    if (existing_segment) {
+        return existing_segment;
+    }
+    /*
+      Several threads may try to create the same segment. Only one of them
+      succeeds in installing its segment, the others discard theirs.
+    */
+    size_t segment_size =
+        static_cast<size_t>(num_bins) << states_per_segment_log;
+    PackedStateBin *new_segment = new PackedStateBin[segment_size];
+    if (segment.compare_exchange_strong(
+            existing_segment, new_segment, memory_order_acq_rel,
+            memory_order_acquire)) {
+        return new_segment;
+    }
+    delete[] new_segment;
+    return existing_segment;
+}
+
+StateID ConcurrentStateRegistry::reserve_id() {
+    int_hash_set::KeyType id = num_states.fetch_add(1, memory_order_relaxed);
+    if (id < 0 || id >= max_num_states) {
+        cerr << "ConcurrentStateRegistry surpassed maximum number of states. "
+                "Aborting."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    return StateID(id);
+}
+
+int ConcurrentStateRegistry::get_shard_index(
+    int_hash_set::HashType hash) const {
+    return int_hash_set::get_partition(hash, shards.size());
+}
+
+pair<StateID, bool> ConcurrentStateRegistry::insert_state(
+    const PackedStateBin *buffer) {
+    int_hash_set::HashType hash = kernels.hash(buffer, num_bins);
+    Shard &shard = *shards[get_shard_index(hash)];
+    lock_guard<mutex> lock(shard.mutex);
+    shard.candidate_buffer = buffer;
+    shard.candidate_hash = hash;
+    int_hash_set::KeyType key = shard.registered_states.find(CANDIDATE_KEY);
+    if (key != -1) {
+        return make_pair(StateID(key), false);
+    }
+
+    StateID id = reserve_id();
+    PackedStateBin *segment =
+        get_or_create_segment(
+            static_cast<int>(id.value >> states_per_segment_log));
+    int offset =
+        static_cast<int>(id.value & ((1 << states_per_segment_log) - 1));
+    copy(
+        buffer, buffer + num_bins,
+        segment + static_cast<size_t>(offset) * num_bins);
+    shard.registered_states.insert(id.value);
+    return make_pair(id, true);
+}
+
+StateID ConcurrentStateRegistry::get_initial_state() {
+    // Avoid garbage values in half-full bins.
+    vector<PackedStateBin> buffer(num_bins, 0);
+    State initial_state = task_proxy.get_initial_state();
+    for (size_t i = 0; i < initial_state.size(); ++i) {
+        state_packer.set(buffer.data(), i, initial_state[i].get_value());
+    }
+    return insert_state(buffer.data()).first;
+}
+
+pair<StateID, bool> ConcurrentStateRegistry::get_successor_state(
+    StateID predecessor, const OperatorProxy &op, int thread_id) {
+    assert(!op.is_axiom());
+    assert(utils::in_bounds(thread_id, thread_data));
+    ThreadData &data = thread_data[thread_id];
+    const PackedStateBin *predecessor_buffer = lookup_buffer(predecessor);
+    PackedStateBin *buffer = data.buffer.data();
+    copy(predecessor_buffer, predecessor_buffer + num_bins, buffer);
+
+    auto effect_fires = [&](const EffectProxy &effect) {
+        for (FactProxy condition : effect.get_conditions()) {
+            FactPair condition_pair = condition.get_pair();
+            if (state_packer.get(predecessor_buffer, condition_pair.var) !=
+                condition_pair.value) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (has_axioms) {
+        vector<int> &values = data.values;
+        for (size_t var = 0; var < values.size(); ++var) {
+            values[var] = state_packer.get(predecessor_buffer, var);
+        }
+        for (EffectProxy effect : op.get_effects()) {
+            if (effect_fires(effect)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                values[effect_pair.var] = effect_pair.value;
+            }
+        }
+        data.axiom_evaluator->evaluate(values);
+        for (size_t var = 0; var < values.size(); ++var) {
+            state_packer.set(buffer, var, values[var]);
+        }
+    } else {
+        for (EffectProxy effect : op.get_effects()) {
+            if (effect_fires(effect)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                state_packer.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+    }
+    return insert_state(buffer);
+}
+
+const PackedStateBin *ConcurrentStateRegistry::lookup_buffer(
+    StateID id) const {
+    return get_buffer(id.value);
+}
+
+State ConcurrentStateRegistry::lookup_state(StateID id) const {
+    const PackedStateBin *buffer = lookup_buffer(id);
+    int num_variables = task_proxy.get_variables().size();
+    vector<int> values(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        values[var] = state_packer.get(buffer, var);
+    }
+    return task_proxy.create_state(move(values));
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy &log) const {
+    int_hash_set::IndexType largest_shard_size = 0;
+    for (const unique_ptr<Shard> &shard : shards) {
+        largest_shard_size =
+            max(largest_shard_size, shard->registered_states.size());
+    }
+    log << "Number of registered states: " << size() << endl;
+    log << "Number of hash set shards: " << shards.size() << endl;
+    log << "Largest hash set shard: " << largest_shard_size << endl;
+}
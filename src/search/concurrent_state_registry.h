@@ -0,0 +1,184 @@
+#ifndef CONCURRENT_STATE_REGISTRY_H
+#define CONCURRENT_STATE_REGISTRY_H
+
+#include "state_id.h"
+#include "state_registry.h"
+#include "task_proxy.h"
+
+#include "algorithms/int_hash_set.h"
+#include "algorithms/int_packer.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class AxiomEvaluator;
+
+namespace utils {
+class LogProxy;
+}
+
+/*
+  A variant of StateRegistry (see state_registry.h) that can be used by
+  several threads at the same time without a global lock.
+
+  The packed state data is stored in a pool of fixed-size segments. The pool
+  grows by atomically installing new segments, so existing state data never
+  moves and can be read without locking. State IDs are handed out densely
+  from an atomic counter, but only for states that are actually new.
+
+  Duplicate detection uses a striped hash set: the states are distributed
+  among a number of shards based on their hash value, and each shard consists
+  of a hopscotch hash set (see IntHashSet) protected by its own lock. Threads
+  only contend if they insert states that belong to the same shard at the
+  same time, which is rare if there are many more shards than threads.
+
+  Since the registry does not know about State objects, it works with packed
+  buffers and StateIDs only. The data of a state can be read by any thread
+  that obtained its ID from insert_state() or get_successor_state(), or that
+  received it from such a thread with proper synchronization.
+*/
+class ConcurrentStateRegistry {
+    /*
+      A shard looks up states by ID, except for the special key CANDIDATE_KEY
+      which refers to the state that is currently being inserted. This allows
+      to search for a state before it is stored in the pool, so we never have
+      to hand out (and waste) IDs for duplicates.
+    */
+    static const int_hash_set::KeyType CANDIDATE_KEY;
+
+    struct Shard;
+
+    struct ShardHash {
+        const ConcurrentStateRegistry &registry;
+        const Shard &shard;
+        ShardHash(const ConcurrentStateRegistry &registry, const Shard &shard)
+            : registry(registry), shard(shard) {
+        }
+        int_hash_set::HashType operator()(int_hash_set::KeyType key) const;
+    };
+
+    struct ShardEqual {
+        const ConcurrentStateRegistry &registry;
+        const Shard &shard;
+        ShardEqual(const ConcurrentStateRegistry &registry, const Shard &shard)
+            : registry(registry), shard(shard) {
+        }
+        bool operator()(
+            int_hash_set::KeyType lhs, int_hash_set::KeyType rhs) const;
+    };
+
+    using ShardSet = int_hash_set::IntHashSet<ShardHash, ShardEqual>;
+
+    // Align shards to cache lines to avoid false sharing between their locks.
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        const PackedStateBin *candidate_buffer;
+        int_hash_set::HashType candidate_hash;
+        ShardSet registered_states;
+
+        Shard(const ConcurrentStateRegistry &registry);
+    };
+
+    struct ThreadData {
+        std::vector<PackedStateBin> buffer;
+        std::vector<int> values;
+        std::unique_ptr<AxiomEvaluator> axiom_evaluator;
+    };
+
+    TaskProxy task_proxy;
+    const int_packer::IntPacker &state_packer;
+    const int num_bins;
+    const StateDataKernels kernels;
+    const bool has_axioms;
+
+    const int states_per_segment_log;
+    const int_hash_set::KeyType max_num_states;
+    std::vector<std::atomic<PackedStateBin *>> segments;
+    std::atomic<int_hash_set::KeyType> num_states;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<ThreadData> thread_data;
+
+    const PackedStateBin *get_buffer(int_hash_set::KeyType index) const;
+    PackedStateBin *get_or_create_segment(int segment_index);
+    StateID reserve_id();
+    int get_shard_index(int_hash_set::HashType hash) const;
+
+public:
+    /*
+      Create a registry that can be used by num_threads threads. Threads are
+      identified by an ID in [0, num_threads) which must be passed to methods
+      that use scratch space. No two threads may use the same ID at the same
+      time. num_shards is rounded up to the next power of 2.
+    */
+    ConcurrentStateRegistry(
+        const TaskProxy &task_proxy, int num_threads, int num_shards);
+    ~ConcurrentStateRegistry();
+
+    ConcurrentStateRegistry(const ConcurrentStateRegistry &) = delete;
+    ConcurrentStateRegistry &operator=(const ConcurrentStateRegistry &) =
+        delete;
+
+    const TaskProxy &get_task_proxy() const {
+        return task_proxy;
+    }
+
+    int get_bins_per_state() const {
+        return num_bins;
+    }
+
+    /*
+      Register the state with the given packed data if this was not done
+      before. Return its ID and whether it is a new state. Safe to call from
+      several threads concurrently.
+    */
+    std::pair<StateID, bool> insert_state(const PackedStateBin *buffer);
+
+    /*
+      Register the initial state of the task if this was not done before and
+      return its ID.
+    */
+    StateID get_initial_state();
+
+    /*
+      Register the state that results from applying op to the registered
+      state predecessor if this was not done before. Return its ID and
+      whether it is a new state. Safe to call concurrently, as long as every
+      thread uses its own thread_id.
+    */
+    std::pair<StateID, bool> get_successor_state(
+        StateID predecessor, const OperatorProxy &op, int thread_id);
+
+    /*
+      Return the packed data of the state with the given ID. The pointer stays
+      valid as long as the registry exists.
+    */
+    const PackedStateBin *lookup_buffer(StateID id) const;
+
+    /*
+      Return the state with the given ID as an unregistered state.
+    */
+    State lookup_state(StateID id) const;
+
+    /*
+      Return the number of states registered so far. While other threads
+      insert states, the result may already be outdated on return.
+    */
+    int_hash_set::KeyType size() const {
+        return num_states.load(std::memory_order_relaxed);
+    }
+
+    int get_num_shards() const {
+        return shards.size();
+    }
+
+    /*
+      Print statistics. Must not be called while other threads insert states.
+    */
+    void print_statistics(utils::LogProxy &log) const;
+};
+
+#endif
@@ -54,6 +54,22 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+void EvaluationContext::set_result(
+    Evaluator *evaluator, const EvaluationResult &result) {
+    EvaluationResult &cached_result = cache[evaluator];
+    assert(cached_result.is_uninitialized());
+    cached_result = result;
+    evaluator->cache_estimate(state, result);
+    if (statistics && evaluator->is_used_for_counting_evaluations() &&
+        result.get_count_evaluation()) {
+        statistics->inc_evaluations();
+    }
+}
+
+bool EvaluationContext::has_result(Evaluator *evaluator) const {
+    return cache.contains_result(evaluator);
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
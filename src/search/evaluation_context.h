@@ -88,6 +88,15 @@ public:
         bool calculate_preferred = false);
 
     const EvaluationResult &get_result(Evaluator *eval);
+    /*
+      Store a result that was computed outside of this context, e.g. by a copy
+      of the evaluator that runs in another thread. The evaluator must not have
+      been evaluated in this context before. Statistics and the estimate cache
+      of the evaluator are updated as if the result had been computed by
+      get_result().
+    */
+    void set_result(Evaluator *eval, const EvaluationResult &result);
+    bool has_result(Evaluator *eval) const;
     const EvaluatorCache &get_cache() const;
     const State &get_state() const;
     int get_g_value() const;
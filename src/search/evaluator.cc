@@ -4,6 +4,7 @@
 #include "utils/logging.h"
 #include "utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -24,6 +25,18 @@ bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+void Evaluator::get_evaluators(vector<Evaluator *> &evals) {
+    if (find(evals.begin(), evals.end(), this) == evals.end()) {
+        evals.push_back(this);
+    }
+}
+
+void Evaluator::compute_batch_results(const vector<EvaluationContext *> &) {
+}
+
+void Evaluator::print_statistics() const {
+}
+
 void Evaluator::report_value_for_initial_state(
     const EvaluationResult &result) const {
     if (log.is_at_least_normal()) {
@@ -73,6 +86,9 @@ int Evaluator::get_cached_estimate(const State &) const {
     ABORT("Called get_cached_estimate when estimate is not cached.");
 }
 
+void Evaluator::cache_estimate(const State &, const EvaluationResult &) {
+}
+
 void add_evaluator_options_to_feature(
     plugins::Feature &feature, const string &description) {
     feature.add_option<string>(
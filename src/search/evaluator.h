@@ -7,6 +7,7 @@
 #include "utils/logging.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class State;
@@ -50,6 +51,15 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      get_evaluators should append this evaluator and all evaluators
+      that it directly or indirectly depends on to the result, unless
+      they are already contained in it. The default implementation only
+      appends this evaluator. Keeping the order in which evaluators are
+      found makes the order of their statistics deterministic.
+    */
+    virtual void get_evaluators(std::vector<Evaluator *> &evals);
+
     virtual void notify_initial_state(const State & /*initial_state*/) {
     }
 
@@ -81,6 +91,23 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_batch_results may compute the results for all given
+      evaluation contexts at once and store them in the contexts with
+      EvaluationContext::set_result. This gives evaluators the chance to
+      amortize work over all successors of an expansion. Results for
+      contexts that the evaluator skips are computed on demand by
+      compute_result as usual.
+
+      Evaluators that depend on other evaluators should forward the call
+      to them. The default implementation does nothing.
+    */
+    virtual void compute_batch_results(
+        const std::vector<EvaluationContext *> &eval_contexts);
+
+    // Print statistics collected during the search. The default does nothing.
+    virtual void print_statistics() const;
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
@@ -96,6 +123,14 @@ public:
       the given state is cached, i.e., is_estimate_cached returns true.
     */
     virtual int get_cached_estimate(const State &state) const;
+    /*
+      Store a result for the given state that another instance of this
+      evaluator (e.g. a copy running in another thread) has computed, as if
+      it had been computed by this evaluator. Evaluators that do not cache
+      estimates ignore the result.
+    */
+    virtual void cache_estimate(
+        const State &state, const EvaluationResult &result);
 };
 
 using TaskIndependentEvaluator =
@@ -17,6 +17,7 @@ class EvaluatorCache {
 
 public:
     EvaluationResult &operator[](Evaluator *eval);
+    bool contains_result(Evaluator *eval) const;
 
     template<class Callback>
     void for_each_evaluator_result(const Callback &callback) const {
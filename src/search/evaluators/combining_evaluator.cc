@@ -50,11 +50,24 @@ EvaluationResult CombiningEvaluator::compute_result(
     return result;
 }
 
+void CombiningEvaluator::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &subevaluator : subevaluators)
+        subevaluator->compute_batch_results(eval_contexts);
+}
+
 void CombiningEvaluator::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (auto &subevaluator : subevaluators)
         subevaluator->get_path_dependent_evaluators(evals);
 }
+
+void CombiningEvaluator::get_evaluators(vector<Evaluator *> &evals) {
+    Evaluator::get_evaluators(evals);
+    for (auto &subevaluator : subevaluators)
+        subevaluator->get_evaluators(evals);
+}
+
 void add_combining_evaluator_options_to_feature(
     plugins::Feature &feature, const string &description) {
     feature.add_list_option<shared_ptr<TaskIndependentEvaluator>>(
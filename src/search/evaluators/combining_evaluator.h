@@ -40,9 +40,12 @@ public:
     virtual bool dead_ends_are_reliable() const override;
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_batch_results(
+        const std::vector<EvaluationContext *> &eval_contexts) override;
 
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) override;
+    virtual void get_evaluators(std::vector<Evaluator *> &evals) override;
 };
 
 extern void add_combining_evaluator_options_to_feature(
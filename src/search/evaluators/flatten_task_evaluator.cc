@@ -0,0 +1,70 @@
+#include "flatten_task_evaluator.h"
+
+#include "../plugins/plugin.h"
+#include "../tasks/flattened_task.h"
+
+#include <utility>
+
+using namespace std;
+
+namespace flatten_task_evaluator {
+shared_ptr<Evaluator>
+TaskIndependentFlattenTaskEvaluator::create_task_specific_component(
+    const shared_ptr<AbstractTask> &task) const {
+    shared_ptr<AbstractTask> flattened_task =
+        make_shared<tasks::FlattenedTask>(task);
+    return nested->bind_task(flattened_task);
+}
+
+TaskIndependentFlattenTaskEvaluator::TaskIndependentFlattenTaskEvaluator(
+    shared_ptr<TaskIndependentEvaluator> nested)
+    : nested(move(nested)) {
+}
+
+class FlattenTaskEvaluatorFeature
+    : public plugins::TypedFeature<TaskIndependentEvaluator> {
+public:
+    FlattenTaskEvaluatorFeature() : TypedFeature("eval_flatten_task") {
+        document_title("Task-flattening evaluator");
+        document_subcategory("evaluators_basic");
+        document_synopsis(
+            "Evaluates the nested evaluator on a copy of the task that is "
+            "stored in flat arrays. This is useful if the task is the result "
+            "of task transformations such as cost adaptations, because the "
+            "nested evaluator then no longer has to go through all "
+            "transformations whenever it queries the task. The copy needs "
+            "about as much memory as the operators of the task. Evaluators "
+            "that only support specific task transformations, like the "
+            "landmark heuristics, do not support flattened tasks.");
+
+        add_option<shared_ptr<TaskIndependentEvaluator>>(
+            "nested", "the evaluator that should be computed on the "
+                      "flattened task");
+
+        document_language_support(
+            "action costs", "supported if the nested evaluator supports them");
+        document_language_support(
+            "conditional effects",
+            "supported if the nested evaluator supports them");
+        document_language_support(
+            "axioms", "supported if the nested evaluator supports them");
+
+        document_property(
+            "admissible", "yes, if the nested evaluator is admissible");
+        document_property(
+            "consistent", "yes, if the nested evaluator is consistent");
+        document_property("safe", "yes, if the nested evaluator is safe");
+        document_property(
+            "preferred operators",
+            "yes, if the nested evaluator identifies preferred operators");
+    }
+
+    virtual shared_ptr<TaskIndependentEvaluator> create_component(
+        const plugins::Options &opts) const override {
+        return make_shared<TaskIndependentFlattenTaskEvaluator>(
+            opts.get<shared_ptr<TaskIndependentEvaluator>>("nested"));
+    }
+};
+
+static plugins::FeaturePlugin<FlattenTaskEvaluatorFeature> _plugin;
+}
@@ -0,0 +1,24 @@
+#ifndef EVALUATORS_FLATTEN_TASK_EVALUATOR_H
+#define EVALUATORS_FLATTEN_TASK_EVALUATOR_H
+
+#include "../evaluator.h"
+
+#include <memory>
+
+namespace flatten_task_evaluator {
+/*
+  Binds the nested evaluator to a tasks::FlattenedTask of the task it is
+  used for. This does not create an evaluator of its own.
+*/
+class TaskIndependentFlattenTaskEvaluator : public TaskIndependentEvaluator {
+    std::shared_ptr<TaskIndependentEvaluator> nested;
+
+    virtual std::shared_ptr<Evaluator> create_task_specific_component(
+        const std::shared_ptr<AbstractTask> &task) const override;
+public:
+    explicit TaskIndependentFlattenTaskEvaluator(
+        std::shared_ptr<TaskIndependentEvaluator> nested);
+};
+}
+
+#endif
@@ -19,6 +19,11 @@ void ModifyCostsEvaluator::get_path_dependent_evaluators(
     nested->get_path_dependent_evaluators(evals);
 }
 
+void ModifyCostsEvaluator::get_evaluators(vector<Evaluator *> &evals) {
+    Evaluator::get_evaluators(evals);
+    nested->get_evaluators(evals);
+}
+
 void ModifyCostsEvaluator::notify_initial_state(const State &initial_state) {
     /*
       TODO issue1208: Once we remove the task transformation code from
@@ -42,6 +47,17 @@ EvaluationResult ModifyCostsEvaluator::compute_result(
     return nested->compute_result(eval_context);
 }
 
+void ModifyCostsEvaluator::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    /*
+      Since compute_result() calls the nested evaluator directly, results
+      that nested stores in the evaluation contexts are only reused if
+      nested also caches them.
+    */
+    if (nested->does_cache_estimates())
+        nested->compute_batch_results(eval_contexts);
+}
+
 bool ModifyCostsEvaluator::does_cache_estimates() const {
     return nested->does_cache_estimates();
 }
@@ -56,6 +72,12 @@ int ModifyCostsEvaluator::get_cached_estimate(const State &state) const {
     return nested->get_cached_estimate(state);
 }
 
+void ModifyCostsEvaluator::cache_estimate(
+    const State &state, const EvaluationResult &result) {
+    // TODO issue1208: see above
+    nested->cache_estimate(state, result);
+}
+
 shared_ptr<Evaluator>
 TaskIndependentModifyCostsEvaluator::create_task_specific_component(
     const shared_ptr<AbstractTask> &task) const {
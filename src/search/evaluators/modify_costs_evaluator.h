@@ -19,15 +19,20 @@ public:
     virtual bool dead_ends_are_reliable() const override;
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) override;
+    virtual void get_evaluators(std::vector<Evaluator *> &evals) override;
     virtual void notify_initial_state(const State &initial_state) override;
     virtual void notify_state_transition(
         const State &parent_state, OperatorID op_id,
         const State &state) override;
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_batch_results(
+        const std::vector<EvaluationContext *> &eval_contexts) override;
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
     virtual int get_cached_estimate(const State &state) const override;
+    virtual void cache_estimate(
+        const State &state, const EvaluationResult &result) override;
 };
 
 class TaskIndependentModifyCostsEvaluator : public TaskIndependentEvaluator {
@@ -38,10 +38,20 @@ EvaluationResult WeightedEvaluator::compute_result(
     return result;
 }
 
+void WeightedEvaluator::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    evaluator->compute_batch_results(eval_contexts);
+}
+
 void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+void WeightedEvaluator::get_evaluators(vector<Evaluator *> &evals) {
+    Evaluator::get_evaluators(evals);
+    evaluator->get_evaluators(evals);
+}
+
 class WeightedEvaluatorFeature
     : public plugins::TypedFeature<TaskIndependentEvaluator> {
 public:
@@ -31,6 +31,35 @@ State Heuristic::convert_ancestor_state(const State &ancestor_state) const {
     return task_proxy.convert_ancestor_state(ancestor_state);
 }
 
+const vector<int> &Heuristic::convert_ancestor_state_values(
+    const State &ancestor_state) {
+    if (ancestor_state.get_task().get_id() == task_proxy.get_id()) {
+        ancestor_state.unpack();
+        return ancestor_state.get_unpacked_values();
+    }
+    task_proxy.convert_ancestor_state_values(
+        ancestor_state, converted_state_values);
+    return converted_state_values;
+}
+
+span<const int> Heuristic::convert_ancestor_state_batch(
+    span<const State> ancestor_states) {
+    batch_state_values.clear();
+    batch_state_values.reserve(
+        ancestor_states.size() * task_proxy.get_variables().size());
+    for (const State &ancestor_state : ancestor_states) {
+        const vector<int> &values =
+            convert_ancestor_state_values(ancestor_state);
+        batch_state_values.insert(
+            batch_state_values.end(), values.begin(), values.end());
+    }
+    return batch_state_values;
+}
+
+bool Heuristic::compute_heuristic_batch(span<const State>, span<int>) {
+    return false;
+}
+
 void add_heuristic_options_to_feature(
     plugins::Feature &feature, const string &description) {
     feature.add_option<bool>(
@@ -98,6 +127,43 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     return result;
 }
 
+void Heuristic::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    /*
+      We skip contexts in which preferred operators are requested and
+      states with cached estimates, which compute_result handles as usual.
+    */
+    assert(batch_contexts.empty() && batch_states.empty());
+    for (EvaluationContext *eval_context : eval_contexts) {
+        const State &state = eval_context->get_state();
+        if (eval_context->has_result(this) ||
+            eval_context->get_calculate_preferred() ||
+            (cache_evaluator_values && heuristic_cache[state].h != NO_VALUE &&
+             !heuristic_cache[state].dirty))
+            continue;
+        batch_contexts.push_back(eval_context);
+        batch_states.push_back(state);
+    }
+
+    // A single state is cheaper to evaluate with compute_result.
+    batch_values.resize(batch_states.size());
+    if (batch_states.size() > 1 &&
+        compute_heuristic_batch(batch_states, batch_values)) {
+        for (size_t i = 0; i < batch_contexts.size(); ++i) {
+            int heuristic = batch_values[i];
+            assert(heuristic == DEAD_END || heuristic >= 0);
+            EvaluationResult result;
+            result.set_evaluator_value(
+                heuristic == DEAD_END ? EvaluationResult::INFTY : heuristic);
+            result.set_count_evaluation(true);
+            // This also stores the estimate in the heuristic cache.
+            batch_contexts[i]->set_result(this, result);
+        }
+    }
+    batch_contexts.clear();
+    batch_states.clear();
+}
+
 bool Heuristic::does_cache_estimates() const {
     return cache_evaluator_values;
 }
@@ -110,3 +176,12 @@ int Heuristic::get_cached_estimate(const State &state) const {
     assert(is_estimate_cached(state));
     return heuristic_cache[state].h;
 }
+
+void Heuristic::cache_estimate(
+    const State &state, const EvaluationResult &result) {
+    if (cache_evaluator_values) {
+        int heuristic =
+            result.is_infinite() ? DEAD_END : result.get_evaluator_value();
+        heuristic_cache[state] = HEntry(heuristic, false);
+    }
+}
@@ -9,6 +9,8 @@
 #include "algorithms/ordered_set.h"
 
 #include <memory>
+#include <span>
+#include <vector>
 
 class TaskProxy;
 
@@ -42,6 +44,15 @@ class Heuristic : public Evaluator {
     */
     ordered_set::OrderedSet<OperatorID> preferred_operators;
 
+    // Reused by convert_ancestor_state_values() to avoid allocations.
+    std::vector<int> converted_state_values;
+
+    // Reused by compute_batch_results() to avoid allocations.
+    std::vector<EvaluationContext *> batch_contexts;
+    std::vector<State> batch_states;
+    std::vector<int> batch_values;
+    std::vector<int> batch_state_values;
+
 protected:
     /*
       Cache for saving h values
@@ -59,6 +70,19 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Compute the heuristic values of all given states at once and store
+      them in values, using DEAD_END for dead ends like compute_heuristic.
+      Return false if the heuristic has no batch implementation, in which
+      case the states are evaluated one by one with compute_heuristic. This
+      is the default.
+
+      Batch implementations cannot mark preferred operators. They are only
+      called for states for which no preferred operators are requested.
+    */
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states, std::span<int> values);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -68,6 +92,24 @@ protected:
 
     State convert_ancestor_state(const State &ancestor_state) const;
 
+    /*
+      Return the values of the given state converted to the task of the
+      heuristic. This avoids creating a new State object for every
+      evaluation. The returned reference is only valid until the next call
+      and as long as ancestor_state exists.
+    */
+    const std::vector<int> &convert_ancestor_state_values(
+        const State &ancestor_state);
+
+    /*
+      Like convert_ancestor_state_values(), but for several states. The
+      values are stored row by row, i.e., the value of variable var in
+      the i-th state is at position i * num_variables + var. The returned
+      span is only valid until the next call.
+    */
+    std::span<const int> convert_ancestor_state_batch(
+        std::span<const State> ancestor_states);
+
 public:
     Heuristic(
         const std::shared_ptr<AbstractTask> &task, bool cache_estimates,
@@ -79,10 +121,14 @@ public:
 
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
+    virtual void compute_batch_results(
+        const std::vector<EvaluationContext *> &eval_contexts) override;
 
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
     virtual int get_cached_estimate(const State &state) const override;
+    virtual void cache_estimate(
+        const State &state, const EvaluationResult &result) override;
 };
 
 extern void add_heuristic_options_to_feature(
@@ -4,6 +4,7 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <utility>
@@ -22,11 +23,31 @@ BlindSearchHeuristic::BlindSearchHeuristic(
 }
 
 int BlindSearchHeuristic::compute_heuristic(const State &ancestor_state) {
-    State state = convert_ancestor_state(ancestor_state);
-    if (task_properties::is_goal_state(task_proxy, state))
-        return 0;
-    else
-        return min_operator_cost;
+    const vector<int> &state_values =
+        convert_ancestor_state_values(ancestor_state);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        FactPair goal_fact = goal.get_pair();
+        if (state_values[goal_fact.var] != goal_fact.value)
+            return min_operator_cost;
+    }
+    return 0;
+}
+
+bool BlindSearchHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    span<const int> state_values =
+        convert_ancestor_state_batch(ancestor_states);
+    int num_variables = task_proxy.get_variables().size();
+    fill(values.begin(), values.end(), 0);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        FactPair goal_fact = goal.get_pair();
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (state_values[i * num_variables + goal_fact.var] !=
+                goal_fact.value)
+                values[i] = min_operator_cost;
+        }
+    }
+    return true;
 }
 
 class BlindSearchHeuristicFeature
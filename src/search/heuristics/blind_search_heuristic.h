@@ -8,6 +8,9 @@ class BlindSearchHeuristic : public Heuristic {
     int min_operator_cost;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 public:
     BlindSearchHeuristic(
         const std::shared_ptr<AbstractTask> &task, bool cache_estimates,
@@ -3,6 +3,7 @@
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -17,18 +18,37 @@ GoalCountHeuristic::GoalCountHeuristic(
 }
 
 int GoalCountHeuristic::compute_heuristic(const State &ancestor_state) {
-    State state = convert_ancestor_state(ancestor_state);
+    const vector<int> &state_values =
+        convert_ancestor_state_values(ancestor_state);
     int unsatisfied_goal_count = 0;
 
     for (FactProxy goal : task_proxy.get_goals()) {
-        const VariableProxy var = goal.get_variable();
-        if (state[var] != goal) {
+        FactPair goal_fact = goal.get_pair();
+        if (state_values[goal_fact.var] != goal_fact.value) {
             ++unsatisfied_goal_count;
         }
     }
     return unsatisfied_goal_count;
 }
 
+bool GoalCountHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    span<const int> state_values =
+        convert_ancestor_state_batch(ancestor_states);
+    int num_variables = task_proxy.get_variables().size();
+    fill(values.begin(), values.end(), 0);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        FactPair goal_fact = goal.get_pair();
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (state_values[i * num_variables + goal_fact.var] !=
+                goal_fact.value) {
+                ++values[i];
+            }
+        }
+    }
+    return true;
+}
+
 class GoalCountHeuristicFeature
     : public plugins::TypedFeature<TaskIndependentEvaluator> {
 public:
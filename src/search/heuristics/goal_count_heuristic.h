@@ -7,6 +7,9 @@ namespace goal_count_heuristic {
 class GoalCountHeuristic : public Heuristic {
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 public:
     GoalCountHeuristic(
         const std::shared_ptr<AbstractTask> &task, bool cache_estimates,
@@ -1,34 +1,180 @@
 #include "lm_cut_heuristic.h"
 
 #include "lm_cut_landmarks.h"
+#include "lm_cut_landmarks_flat.h"
 
 #include "../task_proxy.h"
 
 #include "../plugins/plugin.h"
 #include "../task_utils/task_properties.h"
+#include "../tasks/root_task.h"
 #include "../utils/logging.h"
+#include "../utils/markup.h"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
 
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(
-    const shared_ptr<AbstractTask> &task, bool cache_estimates,
-    const string &description, utils::Verbosity verbosity)
+    const shared_ptr<AbstractTask> &task,
+    LandmarkCutImplementation implementation, int max_cached_states,
+    bool cache_estimates, const string &description,
+    utils::Verbosity verbosity)
     : Heuristic(task, cache_estimates, description, verbosity),
-      landmark_generator(make_unique<LandmarkCutLandmarks>(task_proxy)) {
+      max_cached_states(max_cached_states),
+      cached_registry(nullptr),
+      pending_parent_id(StateID::no_state),
+      pending_state_id(StateID::no_state),
+      pending_root_op_id(-1) {
     if (log.is_at_least_normal()) {
         log << "Initializing landmark cut heuristic..." << endl;
     }
+    if (implementation == LandmarkCutImplementation::FLAT) {
+        flat_landmark_generator =
+            make_unique<FlatLandmarkCutLandmarks>(task_proxy);
+    } else {
+        landmark_generator = make_unique<LandmarkCutLandmarks>(task_proxy);
+    }
+    if (max_cached_states > 0) {
+        OperatorsProxy operators = task_proxy.get_operators();
+        root_operator_ids.reserve(operators.size());
+        for (OperatorProxy op : operators) {
+            root_operator_ids.push_back(
+                op.get_ancestor_operator_id(tasks::g_root_task.get())
+                    .get_index());
+        }
+        if (log.is_at_least_normal()) {
+            log << "Reusing landmarks of up to " << max_cached_states
+                << " cached states" << endl;
+        }
+    }
 }
 
-int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
+void LandmarkCutHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    if (max_cached_states > 0)
+        evals.insert(this);
+}
+
+void LandmarkCutHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID op_id, const State &state) {
+    pending_parent_id = parent_state.get_id();
+    pending_state_id = state.get_id();
+    pending_root_op_id = op_id.get_index();
+}
+
+void LandmarkCutHeuristic::cache_landmarks(
+    const State &state, vector<int> &&landmarks) {
+    if (state.get_registry() != cached_registry) {
+        cached_landmarks.clear();
+        cached_states.clear();
+        cached_registry = state.get_registry();
+    }
+    auto [it, inserted] =
+        cached_landmarks.try_emplace(state.get_id(), move(landmarks));
+    if (!inserted) {
+        // The state is reevaluated, e.g. after its cache entry was dirtied.
+        it->second = move(landmarks);
+        return;
+    }
+    cached_states.push_back(state.get_id());
+    if (static_cast<int>(cached_states.size()) > max_cached_states) {
+        cached_landmarks.erase(cached_states.front());
+        cached_states.pop_front();
+    }
+}
+
+void LandmarkCutHeuristic::reset_operator_costs() {
+    if (flat_landmark_generator)
+        flat_landmark_generator->reset_operator_costs();
+    else
+        landmark_generator->reset_operator_costs();
+}
+
+void LandmarkCutHeuristic::reduce_operator_cost(int op_id, int amount) {
+    if (flat_landmark_generator)
+        flat_landmark_generator->reduce_operator_cost(op_id, amount);
+    else
+        landmark_generator->reduce_operator_cost(op_id, amount);
+}
+
+bool LandmarkCutHeuristic::compute_landmarks_for_remaining_costs(
+    const State &ancestor_state,
+    const LandmarkCutLandmarks::CostCallback &cost_callback,
+    const LandmarkCutLandmarks::LandmarkCallback &landmark_callback) {
+    if (flat_landmark_generator) {
+        return flat_landmark_generator->compute_landmarks_for_remaining_costs(
+            convert_ancestor_state_values(ancestor_state), cost_callback,
+            landmark_callback);
+    }
     State state = convert_ancestor_state(ancestor_state);
+    return landmark_generator->compute_landmarks_for_remaining_costs(
+        state, cost_callback, landmark_callback);
+}
+
+int LandmarkCutHeuristic::compute_incremental_heuristic(
+    const State &ancestor_state) {
+    reset_operator_costs();
+    vector<int> landmarks;
+    int total_cost = 0;
+
+    /*
+      Keep the parent's landmarks that do not contain the operator leading
+      to this state together with their costs.
+    */
+    if (ancestor_state.get_id() == pending_state_id &&
+        ancestor_state.get_registry() == cached_registry) {
+        auto it = cached_landmarks.find(pending_parent_id);
+        if (it != cached_landmarks.end()) {
+            const vector<int> &parent_landmarks = it->second;
+            size_t pos = 0;
+            while (pos < parent_landmarks.size()) {
+                int cost = parent_landmarks[pos];
+                int size = parent_landmarks[pos + 1];
+                auto begin = parent_landmarks.begin() + pos + 2;
+                auto end = begin + size;
+                pos += 2 + size;
+                bool contains_op = any_of(begin, end, [this](int op_id) {
+                    return root_operator_ids[op_id] == pending_root_op_id;
+                });
+                if (contains_op)
+                    continue;
+                for (auto op_it = begin; op_it != end; ++op_it)
+                    reduce_operator_cost(*op_it, cost);
+                landmarks.insert(landmarks.end(), begin - 2, end);
+                total_cost += cost;
+            }
+        }
+    }
+    pending_state_id = StateID::no_state;
+
+    bool dead_end = compute_landmarks_for_remaining_costs(
+        ancestor_state, nullptr,
+        [&total_cost, &landmarks](
+            const LandmarkCutLandmarks::Landmark &landmark, int cost) {
+            total_cost += cost;
+            landmarks.push_back(cost);
+            landmarks.push_back(landmark.size());
+            landmarks.insert(landmarks.end(), landmark.begin(), landmark.end());
+        });
+
+    if (dead_end)
+        return DEAD_END;
+    cache_landmarks(ancestor_state, move(landmarks));
+    return total_cost;
+}
+
+int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
+    if (max_cached_states > 0)
+        return compute_incremental_heuristic(ancestor_state);
+
+    reset_operator_costs();
     int total_cost = 0;
-    bool dead_end = landmark_generator->compute_landmarks(
-        state, [&total_cost](int cut_cost) { total_cost += cut_cost; },
-        nullptr);
+    bool dead_end = compute_landmarks_for_remaining_costs(
+        ancestor_state,
+        [&total_cost](int cut_cost) { total_cost += cut_cost; }, nullptr);
 
     if (dead_end)
         return DEAD_END;
@@ -40,7 +186,31 @@ class LandmarkCutHeuristicFeature
 public:
     LandmarkCutHeuristicFeature() : TypedFeature("lmcut") {
         document_title("Landmark-cut heuristic");
+        document_synopsis(
+            "With max_cached_states > 0, the heuristic is computed "
+            "incrementally by reusing the landmarks of the parent state "
+            "as described in the following paper:" +
+            utils::format_conference_reference(
+                {"Florian Pommerening", "Malte Helmert"}, "Incremental LM-Cut",
+                "https://ai.dmi.unibas.ch/papers/pommerening-helmert-icaps2013.pdf",
+                "Proceedings of the Twenty-Third International Conference on "
+                "Automated Planning and Scheduling (ICAPS 2013)",
+                "162-170", "AAAI Press", "2013") +
+            "Incremental estimates depend on the path to the evaluated state "
+            "and may differ from those computed from scratch, but remain "
+            "admissible. Larger caches use more memory and allow reusing "
+            "landmarks more often.");
 
+        add_option<LandmarkCutImplementation>(
+            "implementation",
+            "data structures used for computing the landmarks",
+            "pointers");
+        add_option<int>(
+            "max_cached_states",
+            "maximum number of states whose landmarks are cached and reused "
+            "for computing the heuristic of their successors incrementally "
+            "(set to 0 to compute every state from scratch)",
+            "0", plugins::Bounds("0", "infinity"));
         add_heuristic_options_to_feature(*this, "lmcut");
 
         document_language_support("action costs", "supported");
@@ -57,9 +227,20 @@ public:
         const plugins::Options &opts) const override {
         return components::make_auto_task_independent_component<
             LandmarkCutHeuristic, Evaluator>(
+            opts.get<LandmarkCutImplementation>("implementation"),
+            opts.get<int>("max_cached_states"),
             get_heuristic_arguments_from_options(opts));
     }
 };
 
 static plugins::FeaturePlugin<LandmarkCutHeuristicFeature> _plugin;
+
+static plugins::TypedEnumPlugin<LandmarkCutImplementation> _enum_plugin(
+    {{"pointers",
+      "relaxed operators and propositions are objects that refer to each "
+      "other by pointers"},
+     {"flat",
+      "relaxed operators and propositions are indices into arrays of their "
+      "attributes, and the explorations use a dedicated bucket queue. This "
+      "is meant for tasks with small operator costs"}});
 }
@@ -3,19 +3,74 @@
 
 #include "../heuristic.h"
 
+#include "../utils/hash.h"
+
+#include <deque>
+#include <functional>
 #include <memory>
+#include <vector>
+
+class StateRegistry;
 
 namespace lm_cut_heuristic {
+class FlatLandmarkCutLandmarks;
 class LandmarkCutLandmarks;
 
+enum class LandmarkCutImplementation {
+    POINTERS,
+    FLAT
+};
+
+/*
+  With max_cached_states > 0, the heuristic is computed incrementally as
+  described by Pommerening and Helmert (2013): the landmarks of a state
+  remain landmarks of every successor reached by an operator that does not
+  occur in them. These landmarks keep their costs, and only the remaining
+  operator costs are distributed by new cuts.
+
+  Landmarks are cached for the most recently evaluated states. Each entry
+  is stored flat as a sequence of (cost, size, operator IDs...) records.
+*/
 class LandmarkCutHeuristic : public Heuristic {
+    // Exactly one of the two landmark generators is used.
     std::unique_ptr<LandmarkCutLandmarks> landmark_generator;
+    std::unique_ptr<FlatLandmarkCutLandmarks> flat_landmark_generator;
+    const int max_cached_states;
+
+    // Maps local operator IDs to operator IDs of the root task.
+    std::vector<int> root_operator_ids;
+    const StateRegistry *cached_registry;
+    utils::HashMap<StateID, std::vector<int>> cached_landmarks;
+    // Cached states in insertion order, used for evicting old entries.
+    std::deque<StateID> cached_states;
 
+    // Transition reported last, used to look up the parent's landmarks.
+    StateID pending_parent_id;
+    StateID pending_state_id;
+    int pending_root_op_id;
+
+    void reset_operator_costs();
+    void reduce_operator_cost(int op_id, int amount);
+    bool compute_landmarks_for_remaining_costs(
+        const State &ancestor_state,
+        const std::function<void(int)> &cost_callback,
+        const std::function<void(const std::vector<int> &, int)>
+            &landmark_callback);
+    int compute_incremental_heuristic(const State &ancestor_state);
+    void cache_landmarks(const State &state, std::vector<int> &&landmarks);
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     LandmarkCutHeuristic(
-        const std::shared_ptr<AbstractTask> &task, bool cache_estimates,
-        const std::string &description, utils::Verbosity verbosity);
+        const std::shared_ptr<AbstractTask> &task,
+        LandmarkCutImplementation implementation, int max_cached_states,
+        bool cache_estimates, const std::string &description,
+        utils::Verbosity verbosity);
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
 };
 }
 
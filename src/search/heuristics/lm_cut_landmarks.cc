@@ -269,12 +269,23 @@ void LandmarkCutLandmarks::validate_h_max() const {
 #endif
 }
 
-bool LandmarkCutLandmarks::compute_landmarks(
-    const State &state, const CostCallback &cost_callback,
-    const LandmarkCallback &landmark_callback) {
+void LandmarkCutLandmarks::reset_operator_costs() {
     for (RelaxedOperator &op : relaxed_operators) {
         op.cost = op.base_cost;
     }
+}
+
+bool LandmarkCutLandmarks::compute_landmarks(
+    const State &state, const CostCallback &cost_callback,
+    const LandmarkCallback &landmark_callback) {
+    reset_operator_costs();
+    return compute_landmarks_for_remaining_costs(
+        state, cost_callback, landmark_callback);
+}
+
+bool LandmarkCutLandmarks::compute_landmarks_for_remaining_costs(
+    const State &state, const CostCallback &cost_callback,
+    const LandmarkCallback &landmark_callback) {
     // The following three variables could be declared inside the loop
     // ("second_exploration_queue" even inside second_exploration),
     // but having them here saves reallocations and hence provides a
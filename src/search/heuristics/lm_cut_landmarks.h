@@ -111,6 +111,23 @@ public:
     bool compute_landmarks(
         const State &state, const CostCallback &cost_callback,
         const LandmarkCallback &landmark_callback);
+
+    /*
+      Incremental computation: after reset_operator_costs(), callers may
+      assign costs to previously found landmarks by reducing the costs of
+      their operators with reduce_operator_cost(). Landmarks computed with
+      compute_landmarks_for_remaining_costs() then only use the remaining
+      costs, so their costs can be added to the assigned ones admissibly.
+    */
+    void reset_operator_costs();
+    void reduce_operator_cost(int op_id, int amount) {
+        RelaxedOperator &op = relaxed_operators[op_id];
+        op.cost -= amount;
+        assert(op.cost >= 0);
+    }
+    bool compute_landmarks_for_remaining_costs(
+        const State &state, const CostCallback &cost_callback,
+        const LandmarkCallback &landmark_callback);
 };
 
 inline void RelaxedOperator::update_h_max_supporter() {
@@ -0,0 +1,324 @@
+#include "lm_cut_landmarks_flat.h"
+
+#include "../task_proxy.h"
+
+#include "../task_utils/task_properties.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace lm_cut_heuristic {
+static bool compare_heap_entries(
+    const pair<int, int> &lhs, const pair<int, int> &rhs) {
+    return lhs.first > rhs.first;
+}
+
+ExplorationQueue::ExplorationQueue()
+    : current_bucket_no(0), num_bucket_entries(0) {
+}
+
+void ExplorationQueue::push_overflow(int key, int value) {
+    assert(key != numeric_limits<int>::max());
+    overflow_heap.emplace_back(key, value);
+    push_heap(overflow_heap.begin(), overflow_heap.end(), compare_heap_entries);
+}
+
+pair<int, int> ExplorationQueue::pop_overflow() {
+    pop_heap(overflow_heap.begin(), overflow_heap.end(), compare_heap_entries);
+    pair<int, int> result = overflow_heap.back();
+    overflow_heap.pop_back();
+    return result;
+}
+
+void ExplorationQueue::clear() {
+    for (int i = current_bucket_no; num_bucket_entries != 0; ++i) {
+        num_bucket_entries -= buckets[i].size();
+        buckets[i].clear();
+    }
+    current_bucket_no = 0;
+    overflow_heap.clear();
+}
+
+FlatLandmarkCutLandmarks::FlatLandmarkCutLandmarks(
+    const TaskProxy &task_proxy) {
+    task_properties::verify_no_axioms(task_proxy);
+    task_properties::verify_no_conditional_effects(task_proxy);
+
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_facts = 0;
+    fact_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+    }
+    artificial_precondition = num_facts;
+    artificial_goal = num_facts + 1;
+    num_propositions = num_facts + 2;
+
+    auto get_proposition = [this](const FactProxy &fact) {
+        return fact_offsets[fact.get_variable().get_id()] + fact.get_value();
+    };
+
+    precondition_begin.push_back(0);
+    effect_begin.push_back(0);
+    vector<int> pre;
+    vector<int> eff;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        pre.clear();
+        eff.clear();
+        for (FactProxy fact : op.get_preconditions())
+            pre.push_back(get_proposition(fact));
+        for (EffectProxy effect : op.get_effects())
+            eff.push_back(get_proposition(effect.get_fact()));
+        add_operator(pre, eff, op.get_cost());
+    }
+
+    // The artificial goal operator comes last and is never part of a cut.
+    pre.clear();
+    for (FactProxy goal : task_proxy.get_goals())
+        pre.push_back(get_proposition(goal));
+    add_operator(pre, {artificial_goal}, 0);
+    num_operators = base_costs.size();
+
+    build_occurrences(
+        precondition_begin, preconditions, precondition_of_begin,
+        precondition_of);
+    build_occurrences(effect_begin, effects, effect_of_begin, effect_of);
+
+    operators.resize(num_operators);
+    propositions.resize(num_propositions);
+    reset_operator_costs();
+}
+
+void FlatLandmarkCutLandmarks::add_operator(
+    const vector<int> &pre, const vector<int> &eff, int base_cost) {
+    if (pre.empty())
+        preconditions.push_back(artificial_precondition);
+    else
+        preconditions.insert(preconditions.end(), pre.begin(), pre.end());
+    effects.insert(effects.end(), eff.begin(), eff.end());
+    num_preconditions.push_back(
+        preconditions.size() - precondition_begin.back());
+    precondition_begin.push_back(preconditions.size());
+    effect_begin.push_back(effects.size());
+    base_costs.push_back(base_cost);
+}
+
+void FlatLandmarkCutLandmarks::build_occurrences(
+    const vector<int> &begin, const vector<int> &props,
+    vector<int> &occurrence_begin, vector<int> &occurrences) {
+    // Counting sort keeps the operators of each proposition in order.
+    occurrence_begin.assign(num_propositions + 1, 0);
+    for (int prop : props)
+        ++occurrence_begin[prop + 1];
+    for (int prop = 0; prop < num_propositions; ++prop)
+        occurrence_begin[prop + 1] += occurrence_begin[prop];
+    occurrences.resize(props.size());
+    vector<int> next_position(
+        occurrence_begin.begin(), occurrence_begin.end() - 1);
+    for (int op = 0; op < num_operators; ++op) {
+        for (int i = begin[op]; i < begin[op + 1]; ++i)
+            occurrences[next_position[props[i]]++] = op;
+    }
+}
+
+void FlatLandmarkCutLandmarks::update_h_max_supporter(int op) {
+    OperatorInfo &info = operators[op];
+    assert(!info.unsatisfied_preconditions);
+    span<const int> pre_row = get_row(precondition_begin, preconditions, op);
+    /*
+      Computing the maximum first keeps the common loop free of
+      dependencies between iterations. The supporter is the first
+      precondition with the maximal cost unless the old supporter already
+      has this cost, which matches RelaxedOperator::update_h_max_supporter.
+    */
+    int max_cost = 0;
+    for (int pre : pre_row)
+        max_cost = max(max_cost, propositions[pre].h_max_cost);
+    if (max_cost > propositions[info.h_max_supporter].h_max_cost) {
+        info.h_max_supporter =
+            *find_if(pre_row.begin(), pre_row.end(), [this, max_cost](int pre) {
+                return propositions[pre].h_max_cost == max_cost;
+            });
+    }
+    info.h_max_supporter_cost = propositions[info.h_max_supporter].h_max_cost;
+}
+
+void FlatLandmarkCutLandmarks::first_exploration(
+    const vector<int> &state_values) {
+    queue.clear();
+    for (PropositionInfo &prop : propositions)
+        prop.status = UNREACHED;
+    for (int op = 0; op < num_operators; ++op) {
+        OperatorInfo &info = operators[op];
+        info.unsatisfied_preconditions = num_preconditions[op];
+        info.h_max_supporter = -1;
+        info.h_max_supporter_cost = numeric_limits<int>::max();
+    }
+
+    for (size_t var = 0; var < state_values.size(); ++var)
+        enqueue_if_necessary(fact_offsets[var] + state_values[var], 0);
+    enqueue_if_necessary(artificial_precondition, 0);
+
+    while (!queue.empty()) {
+        auto [popped_cost, prop] = queue.pop();
+        int prop_cost = propositions[prop].h_max_cost;
+        assert(prop_cost <= popped_cost);
+        if (prop_cost < popped_cost)
+            continue;
+        for (int op : get_row(precondition_of_begin, precondition_of, prop)) {
+            OperatorInfo &info = operators[op];
+            --info.unsatisfied_preconditions;
+            assert(info.unsatisfied_preconditions >= 0);
+            if (info.unsatisfied_preconditions == 0) {
+                info.h_max_supporter = prop;
+                info.h_max_supporter_cost = prop_cost;
+                enqueue_effects(op, prop_cost + info.cost);
+            }
+        }
+    }
+}
+
+void FlatLandmarkCutLandmarks::first_exploration_incremental() {
+    assert(queue.empty());
+    for (int op : cut)
+        enqueue_effects(
+            op, operators[op].h_max_supporter_cost + operators[op].cost);
+    while (!queue.empty()) {
+        auto [popped_cost, prop] = queue.pop();
+        int prop_cost = propositions[prop].h_max_cost;
+        assert(prop_cost <= popped_cost);
+        if (prop_cost < popped_cost)
+            continue;
+        for (int op : get_row(precondition_of_begin, precondition_of, prop)) {
+            OperatorInfo &info = operators[op];
+            if (info.h_max_supporter == prop) {
+                int old_supp_cost = info.h_max_supporter_cost;
+                if (old_supp_cost > prop_cost) {
+                    update_h_max_supporter(op);
+                    int new_supp_cost = info.h_max_supporter_cost;
+                    if (new_supp_cost != old_supp_cost) {
+                        // This operator has become cheaper.
+                        assert(new_supp_cost < old_supp_cost);
+                        enqueue_effects(op, new_supp_cost + info.cost);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FlatLandmarkCutLandmarks::second_exploration(
+    const vector<int> &state_values) {
+    assert(second_exploration_queue.empty());
+    assert(cut.empty());
+
+    propositions[artificial_precondition].status = BEFORE_GOAL_ZONE;
+    second_exploration_queue.push_back(artificial_precondition);
+    for (size_t var = 0; var < state_values.size(); ++var) {
+        int init_prop = fact_offsets[var] + state_values[var];
+        propositions[init_prop].status = BEFORE_GOAL_ZONE;
+        second_exploration_queue.push_back(init_prop);
+    }
+
+    while (!second_exploration_queue.empty()) {
+        int prop = second_exploration_queue.back();
+        second_exploration_queue.pop_back();
+        for (int op : get_row(precondition_of_begin, precondition_of, prop)) {
+            if (operators[op].h_max_supporter != prop)
+                continue;
+            span<const int> effect_row = get_row(effect_begin, effects, op);
+            bool reached_goal_zone = any_of(
+                effect_row.begin(), effect_row.end(), [this](int effect) {
+                    return propositions[effect].status == GOAL_ZONE;
+                });
+            if (reached_goal_zone) {
+                assert(operators[op].cost > 0);
+                cut.push_back(op);
+            } else {
+                for (int effect : effect_row) {
+                    PropositionInfo &effect_info = propositions[effect];
+                    if (effect_info.status != BEFORE_GOAL_ZONE) {
+                        assert(effect_info.status == REACHED);
+                        effect_info.status = BEFORE_GOAL_ZONE;
+                        second_exploration_queue.push_back(effect);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FlatLandmarkCutLandmarks::mark_goal_plateau() {
+    assert(goal_plateau_stack.empty());
+    goal_plateau_stack.push_back(artificial_goal);
+    while (!goal_plateau_stack.empty()) {
+        int subgoal = goal_plateau_stack.back();
+        goal_plateau_stack.pop_back();
+        // See LandmarkCutLandmarks::mark_goal_plateau for unreachable
+        // subgoals (-1).
+        if (subgoal == -1 || propositions[subgoal].status == GOAL_ZONE)
+            continue;
+        propositions[subgoal].status = GOAL_ZONE;
+        for (int achiever : get_row(effect_of_begin, effect_of, subgoal)) {
+            if (operators[achiever].cost == 0)
+                goal_plateau_stack.push_back(
+                    operators[achiever].h_max_supporter);
+        }
+    }
+}
+
+void FlatLandmarkCutLandmarks::reset_operator_costs() {
+    for (int op = 0; op < num_operators; ++op)
+        operators[op].cost = base_costs[op];
+}
+
+bool FlatLandmarkCutLandmarks::compute_landmarks(
+    const vector<int> &state_values,
+    const LandmarkCutLandmarks::CostCallback &cost_callback,
+    const LandmarkCutLandmarks::LandmarkCallback &landmark_callback) {
+    reset_operator_costs();
+    return compute_landmarks_for_remaining_costs(
+        state_values, cost_callback, landmark_callback);
+}
+
+bool FlatLandmarkCutLandmarks::compute_landmarks_for_remaining_costs(
+    const vector<int> &state_values,
+    const LandmarkCutLandmarks::CostCallback &cost_callback,
+    const LandmarkCutLandmarks::LandmarkCallback &landmark_callback) {
+    first_exploration(state_values);
+    if (propositions[artificial_goal].status == UNREACHED)
+        return true;
+
+    while (propositions[artificial_goal].h_max_cost != 0) {
+        mark_goal_plateau();
+        second_exploration(state_values);
+        assert(!cut.empty());
+        int cut_cost = numeric_limits<int>::max();
+        for (int op : cut)
+            cut_cost = min(cut_cost, operators[op].cost);
+        for (int op : cut)
+            operators[op].cost -= cut_cost;
+
+        if (cost_callback) {
+            cost_callback(cut_cost);
+        }
+        if (landmark_callback) {
+            // Operator indices are the IDs of the original operators.
+            landmark.assign(cut.begin(), cut.end());
+            landmark_callback(landmark, cut_cost);
+        }
+
+        first_exploration_incremental();
+        cut.clear();
+
+        for (PropositionInfo &prop : propositions) {
+            if (prop.status >= GOAL_ZONE)
+                prop.status = REACHED;
+        }
+    }
+    return false;
+}
+}
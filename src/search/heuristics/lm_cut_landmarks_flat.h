@@ -0,0 +1,178 @@
+#ifndef HEURISTICS_LM_CUT_LANDMARKS_FLAT_H
+#define HEURISTICS_LM_CUT_LANDMARKS_FLAT_H
+
+#include "lm_cut_landmarks.h"
+
+#include <cassert>
+#include <span>
+#include <utility>
+#include <vector>
+
+class TaskProxy;
+
+namespace lm_cut_heuristic {
+/*
+  Bucket-based priority queue for the h^max explorations. Like BucketQueue,
+  it pops entries with the same key in LIFO order, so it explores
+  propositions in the same order as LandmarkCutLandmarks as long as all keys
+  fit into the buckets. Larger keys are kept in a binary heap, which is only
+  used when all buckets are empty.
+*/
+class ExplorationQueue {
+    static const int MAX_BUCKETS = 1024;
+
+    std::vector<std::vector<int>> buckets;
+    int current_bucket_no;
+    int num_bucket_entries;
+    std::vector<std::pair<int, int>> overflow_heap;
+
+    void push_overflow(int key, int value);
+    std::pair<int, int> pop_overflow();
+public:
+    ExplorationQueue();
+
+    void push(int key, int value) {
+        assert(key >= 0);
+        if (key >= MAX_BUCKETS) {
+            push_overflow(key, value);
+            return;
+        }
+        if (key >= static_cast<int>(buckets.size()))
+            buckets.resize(key + 1);
+        else if (key < current_bucket_no)
+            current_bucket_no = key;
+        buckets[key].push_back(value);
+        ++num_bucket_entries;
+    }
+
+    std::pair<int, int> pop() {
+        assert(!empty());
+        if (num_bucket_entries == 0)
+            return pop_overflow();
+        while (buckets[current_bucket_no].empty())
+            ++current_bucket_no;
+        std::vector<int> &bucket = buckets[current_bucket_no];
+        int value = bucket.back();
+        bucket.pop_back();
+        --num_bucket_entries;
+        return std::make_pair(current_bucket_no, value);
+    }
+
+    bool empty() const {
+        return num_bucket_entries == 0 && overflow_heap.empty();
+    }
+    void clear();
+};
+
+/*
+  Data-oriented implementation of the LM-cut exploration with the same
+  interface and results as LandmarkCutLandmarks (up to tie-breaking among
+  propositions with equal h^max values above the bucket range of the
+  queue).
+
+  Propositions and relaxed operators are represented by indices into
+  arrays of their attributes. The preconditions and
+  effects of operators as well as the operators in which a proposition
+  occurs are stored in compressed sparse row format, i.e., as one array of
+  indices plus an array with the start of each range.
+*/
+class FlatLandmarkCutLandmarks {
+    // Proposition index of the first fact of each variable.
+    std::vector<int> fact_offsets;
+    int artificial_precondition;
+    int artificial_goal;
+    int num_propositions;
+    int num_operators;
+
+    std::vector<int> precondition_begin;
+    std::vector<int> preconditions;
+    std::vector<int> effect_begin;
+    std::vector<int> effects;
+    std::vector<int> precondition_of_begin;
+    std::vector<int> precondition_of;
+    std::vector<int> effect_of_begin;
+    std::vector<int> effect_of;
+
+    /*
+      Attributes that the explorations access together are grouped per
+      operator and proposition to avoid one cache miss per attribute.
+    */
+    struct OperatorInfo {
+        int cost;
+        int unsatisfied_preconditions;
+        int h_max_supporter;
+        int h_max_supporter_cost;
+    };
+    struct PropositionInfo {
+        int h_max_cost;
+        int status;
+    };
+    std::vector<int> base_costs;
+    std::vector<int> num_preconditions;
+    std::vector<OperatorInfo> operators;
+    std::vector<PropositionInfo> propositions;
+
+    ExplorationQueue queue;
+    // Reused between calls to avoid reallocations.
+    std::vector<int> second_exploration_queue;
+    std::vector<int> goal_plateau_stack;
+    std::vector<int> cut;
+    LandmarkCutLandmarks::Landmark landmark;
+
+    void add_operator(
+        const std::vector<int> &pre, const std::vector<int> &eff,
+        int base_cost);
+    void build_occurrences(
+        const std::vector<int> &begin, const std::vector<int> &props,
+        std::vector<int> &occurrence_begin, std::vector<int> &occurrences);
+
+    static std::span<const int> get_row(
+        const std::vector<int> &row_begin, const std::vector<int> &entries,
+        int row) {
+        const int *data = entries.data();
+        return std::span<const int>(
+            data + row_begin[row], data + row_begin[row + 1]);
+    }
+
+    void enqueue_if_necessary(int prop, int cost) {
+        assert(cost >= 0);
+        PropositionInfo &info = propositions[prop];
+        if (info.status == UNREACHED || info.h_max_cost > cost) {
+            info.status = REACHED;
+            info.h_max_cost = cost;
+            queue.push(cost, prop);
+        }
+    }
+
+    void enqueue_effects(int op, int cost) {
+        for (int effect : get_row(effect_begin, effects, op))
+            enqueue_if_necessary(effect, cost);
+    }
+
+    void update_h_max_supporter(int op);
+    void first_exploration(const std::vector<int> &state_values);
+    void first_exploration_incremental();
+    void second_exploration(const std::vector<int> &state_values);
+    void mark_goal_plateau();
+public:
+    explicit FlatLandmarkCutLandmarks(const TaskProxy &task_proxy);
+
+    // See LandmarkCutLandmarks.
+    bool compute_landmarks(
+        const std::vector<int> &state_values,
+        const LandmarkCutLandmarks::CostCallback &cost_callback,
+        const LandmarkCutLandmarks::LandmarkCallback &landmark_callback);
+
+    void reset_operator_costs();
+    void reduce_operator_cost(int op_id, int amount) {
+        operators[op_id].cost -= amount;
+        assert(operators[op_id].cost >= 0);
+    }
+    bool compute_landmarks_for_remaining_costs(
+        const std::vector<int> &state_values,
+        const LandmarkCutLandmarks::CostCallback &cost_callback,
+        const LandmarkCutLandmarks::LandmarkCallback &landmark_callback);
+};
+}
+
+#endif
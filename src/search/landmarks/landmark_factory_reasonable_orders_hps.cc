@@ -7,6 +7,7 @@
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/timer.h"
 
 #include <ranges>
 
@@ -31,7 +32,12 @@ void LandmarkFactoryReasonableOrdersHPS::generate_landmarks(
     if (log.is_at_least_normal()) {
         log << "approx. reasonable orders" << endl;
     }
+    utils::Timer reasonable_orders_timer;
     approximate_reasonable_orderings(task_proxy);
+    if (log.is_at_least_normal()) {
+        log << "Time for approximating reasonable orders: "
+            << reasonable_orders_timer << endl;
+    }
 }
 
 void LandmarkFactoryReasonableOrdersHPS::approximate_goal_orderings(
@@ -582,6 +582,53 @@ vector<double> CplexSolverInterface::extract_solution() const {
     return solution;
 }
 
+bool CplexSolverInterface::get_basis(LPBasis &basis) const {
+    if (is_mip || is_trivially_unsolvable()) {
+        return false;
+    }
+    int solution_method;
+    int solution_type;
+    CPX_CALL(
+        CPXsolninfo, env, problem, &solution_method, &solution_type, nullptr,
+        nullptr);
+    if (solution_type != CPX_BASIC_SOLN) {
+        return false;
+    }
+    basis.variable_status.resize(get_num_variables());
+    basis.constraint_status.resize(get_num_constraints());
+    CPX_CALL(
+        CPXgetbase, env, problem, to_cplex_array(basis.variable_status),
+        to_cplex_array(basis.constraint_status));
+    basis.constraint_status.resize(num_permanent_constraints);
+    return true;
+}
+
+void CplexSolverInterface::set_basis(const LPBasis &basis) {
+    assert(static_cast<int>(basis.variable_status.size()) ==
+           get_num_variables());
+    assert(static_cast<int>(basis.constraint_status.size()) ==
+           num_permanent_constraints);
+    if (is_mip) {
+        return;
+    }
+    vector<int> variable_status(basis.variable_status);
+    vector<int> constraint_status(basis.constraint_status);
+    constraint_status.resize(get_num_constraints(), CPX_BASIC);
+    CPX_CALL(
+        CPXcopybase, env, problem, to_cplex_array(variable_status),
+        to_cplex_array(constraint_status));
+}
+
+int CplexSolverInterface::get_num_iterations() const {
+    if (is_trivially_unsolvable()) {
+        return 0;
+    } else if (is_mip) {
+        return static_cast<int>(CPXgetmipitcnt(env, problem));
+    } else {
+        return CPXgetitcnt(env, problem);
+    }
+}
+
 int CplexSolverInterface::get_num_variables() const {
     return CPXgetnumcols(env, problem);
 }
@@ -227,6 +227,18 @@ vector<double> LPSolver::extract_solution() const {
     return pimpl->extract_solution();
 }
 
+bool LPSolver::get_basis(LPBasis &basis) const {
+    return pimpl->get_basis(basis);
+}
+
+void LPSolver::set_basis(const LPBasis &basis) {
+    pimpl->set_basis(basis);
+}
+
+int LPSolver::get_num_iterations() const {
+    return pimpl->get_num_iterations();
+}
+
 int LPSolver::get_num_variables() const {
     return pimpl->get_num_variables();
 }
@@ -79,6 +79,15 @@ struct LPVariable {
         bool is_integer = false);
 };
 
+/*
+  Simplex basis status of each variable and constraint in the encoding of
+  the solver that produced it.
+*/
+struct LPBasis {
+    std::vector<int> variable_status;
+    std::vector<int> constraint_status;
+};
+
 class LinearProgram {
     LPObjectiveSense sense;
     std::string objective_name;
@@ -165,6 +174,11 @@ public:
     */
     std::vector<double> extract_solution() const;
 
+    // See SolverInterface for the following three methods.
+    bool get_basis(LPBasis &basis) const;
+    void set_basis(const LPBasis &basis);
+    int get_num_iterations() const;
+
     int get_num_variables() const;
     int get_num_constraints() const;
     int has_temporary_constraints() const;
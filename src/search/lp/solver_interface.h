@@ -11,6 +11,7 @@ class NamedVector;
 
 namespace lp {
 class LinearProgram;
+struct LPBasis;
 class LPConstraint;
 
 class SolverInterface {
@@ -63,6 +64,22 @@ public:
     */
     virtual std::vector<double> extract_solution() const = 0;
 
+    /*
+      Store the simplex basis of the variables and permanent constraints
+      found by the last call to solve() in basis. Return false if there is
+      no such basis, e.g., because the problem is a MIP.
+    */
+    virtual bool get_basis(LPBasis &basis) const = 0;
+    /*
+      Use the given basis as the starting point of the next call to
+      solve(). The basis must have been extracted from an LP with the same
+      variables and permanent constraints. Temporary constraints start with
+      their slack variables in the basis.
+    */
+    virtual void set_basis(const LPBasis &basis) = 0;
+    // Return the number of simplex iterations of the last call to solve().
+    virtual int get_num_iterations() const = 0;
+
     virtual int get_num_variables() const = 0;
     virtual int get_num_constraints() const = 0;
     virtual bool has_temporary_constraints() const = 0;
@@ -225,6 +225,43 @@ vector<double> SoPlexSolverInterface::extract_solution() const {
     return sol.vec();
 }
 
+bool SoPlexSolverInterface::get_basis(LPBasis &basis) const {
+    if (!soplex.hasBasis())
+        return false;
+    vector<SPxSolverBase<double>::VarStatus> row_status(
+        get_num_constraints());
+    vector<SPxSolverBase<double>::VarStatus> col_status(get_num_variables());
+    soplex.getBasis(row_status.data(), col_status.data());
+    basis.variable_status.assign(col_status.begin(), col_status.end());
+    basis.constraint_status.assign(
+        row_status.begin(), row_status.begin() + num_permanent_constraints);
+    return true;
+}
+
+void SoPlexSolverInterface::set_basis(const LPBasis &basis) {
+    assert(static_cast<int>(basis.variable_status.size()) ==
+           get_num_variables());
+    assert(static_cast<int>(basis.constraint_status.size()) ==
+           num_permanent_constraints);
+    vector<SPxSolverBase<double>::VarStatus> row_status(
+        get_num_constraints(), SPxSolverBase<double>::BASIC);
+    for (int i = 0; i < num_permanent_constraints; ++i) {
+        row_status[i] = static_cast<SPxSolverBase<double>::VarStatus>(
+            basis.constraint_status[i]);
+    }
+    vector<SPxSolverBase<double>::VarStatus> col_status;
+    col_status.reserve(basis.variable_status.size());
+    for (int status : basis.variable_status) {
+        col_status.push_back(
+            static_cast<SPxSolverBase<double>::VarStatus>(status));
+    }
+    soplex.setBasis(row_status.data(), col_status.data());
+}
+
+int SoPlexSolverInterface::get_num_iterations() const {
+    return soplex.numIterations();
+}
+
 int SoPlexSolverInterface::get_num_variables() const {
     return soplex.numCols();
 }
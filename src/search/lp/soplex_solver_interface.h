@@ -59,6 +59,10 @@ public:
 
     virtual std::vector<double> extract_solution() const override;
 
+    virtual bool get_basis(LPBasis &basis) const override;
+    virtual void set_basis(const LPBasis &basis) override;
+    virtual int get_num_iterations() const override;
+
     virtual int get_num_variables() const override;
     virtual int get_num_constraints() const override;
     virtual bool has_temporary_constraints() const override;
@@ -5,6 +5,7 @@
 #include "operator_id.h"
 
 #include <set>
+#include <vector>
 
 class StateID;
 
@@ -89,6 +90,20 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      Append all evaluators that this open list uses (directly or
+      indirectly) to the result. See Evaluator::get_evaluators.
+    */
+    virtual void get_evaluators(std::vector<Evaluator *> &evals) = 0;
+
+    /*
+      Let all evaluators that this open list uses (directly or
+      indirectly) compute their results for the given evaluation contexts
+      in one batch. See Evaluator::compute_batch_results.
+    */
+    virtual void compute_batch_results(
+        const std::vector<EvaluationContext *> &eval_contexts) = 0;
+
     /*
       Accessor method for only_preferred.
 
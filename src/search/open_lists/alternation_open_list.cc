@@ -34,6 +34,9 @@ public:
     virtual void boost_preferred() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
@@ -102,6 +105,19 @@ void AlternationOpenList<Entry>::get_path_dependent_evaluators(
         sublist->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void AlternationOpenList<Entry>::get_evaluators(vector<Evaluator *> &evals) {
+    for (const auto &sublist : open_lists)
+        sublist->get_evaluators(evals);
+}
+
+template<class Entry>
+void AlternationOpenList<Entry>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const auto &sublist : open_lists)
+        sublist->compute_batch_results(eval_contexts);
+}
+
 template<class Entry>
 bool AlternationOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
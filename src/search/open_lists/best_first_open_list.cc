@@ -33,6 +33,9 @@ public:
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
@@ -84,6 +87,17 @@ void BestFirstOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void BestFirstOpenList<Entry>::get_evaluators(vector<Evaluator *> &evals) {
+    evaluator->get_evaluators(evals);
+}
+
+template<class Entry>
+void BestFirstOpenList<Entry>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    evaluator->compute_batch_results(eval_contexts);
+}
+
 template<class Entry>
 bool BestFirstOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
@@ -0,0 +1,291 @@
+#include "bucket_open_list.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+/*
+  Non-negative values are used as array indices. To bound the memory used
+  by the arrays for tasks with large action costs, we switch to a map once
+  the layers and buckets together would use more than MAX_ARRAY_BYTES.
+*/
+static const int64_t MAX_ARRAY_BYTES = 8 << 20;
+
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    using Bucket = deque<Entry>;
+
+    /*
+      All entries with the same primary value, indexed by secondary value.
+      Like the map of the tie-breaking open list, we only keep non-empty
+      buckets, which avoids the memory of empty deques.
+    */
+    struct Layer {
+        vector<unique_ptr<Bucket>> buckets;
+        int size = 0;
+        // No bucket below min_secondary is non-empty.
+        int min_secondary = 0;
+    };
+
+    vector<Layer> layers;
+    // No layer below min_primary is non-empty.
+    int min_primary;
+    int size;
+    // Memory used by the layers and the bucket arrays of all layers.
+    int64_t array_bytes;
+
+    bool use_map;
+    map<pair<int, int>, Bucket> map_buckets;
+
+    shared_ptr<Evaluator> primary_evaluator;
+    shared_ptr<Evaluator> secondary_evaluator;
+
+    bool fits_into_arrays(int primary, int secondary) const;
+    void switch_to_map();
+
+protected:
+    virtual void do_insertion(
+        EvaluationContext &eval_context, const Entry &entry) override;
+
+public:
+    BucketOpenList(
+        const shared_ptr<Evaluator> &primary_eval,
+        const shared_ptr<Evaluator> &secondary_eval, bool pref_only);
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(
+        set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
+    virtual bool is_dead_end(EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(
+    const shared_ptr<Evaluator> &primary_eval,
+    const shared_ptr<Evaluator> &secondary_eval, bool pref_only)
+    : OpenList<Entry>(pref_only),
+      min_primary(0),
+      size(0),
+      array_bytes(0),
+      use_map(false),
+      primary_evaluator(primary_eval),
+      secondary_evaluator(secondary_eval) {
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::fits_into_arrays(
+    int primary, int secondary) const {
+    if (primary < 0 || secondary < 0) {
+        return false;
+    }
+    int64_t new_num_layers =
+        max<int64_t>(layers.size(), static_cast<int64_t>(primary) + 1);
+    int64_t num_buckets =
+        primary < static_cast<int>(layers.size())
+            ? layers[primary].buckets.size()
+            : 0;
+    int64_t new_num_buckets =
+        max<int64_t>(num_buckets, static_cast<int64_t>(secondary) + 1);
+    int64_t new_array_bytes =
+        array_bytes +
+        (new_num_layers - static_cast<int64_t>(layers.size())) *
+            static_cast<int64_t>(sizeof(Layer)) +
+        (new_num_buckets - num_buckets) *
+            static_cast<int64_t>(sizeof(unique_ptr<Bucket>));
+    return new_array_bytes <= MAX_ARRAY_BYTES;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::switch_to_map() {
+    assert(!use_map);
+    for (size_t primary = 0; primary < layers.size(); ++primary) {
+        vector<unique_ptr<Bucket>> &buckets = layers[primary].buckets;
+        for (size_t secondary = 0; secondary < buckets.size(); ++secondary) {
+            if (buckets[secondary]) {
+                map_buckets[make_pair(primary, secondary)] =
+                    move(*buckets[secondary]);
+            }
+        }
+    }
+    vector<Layer>().swap(layers);
+    array_bytes = 0;
+    use_map = true;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int primary =
+        eval_context.get_evaluator_value_or_infinity(primary_evaluator.get());
+    int secondary = eval_context.get_evaluator_value_or_infinity(
+        secondary_evaluator.get());
+    if (!use_map && !fits_into_arrays(primary, secondary)) {
+        switch_to_map();
+    }
+    ++size;
+    if (use_map) {
+        map_buckets[make_pair(primary, secondary)].push_back(entry);
+        return;
+    }
+
+    if (primary >= static_cast<int>(layers.size())) {
+        array_bytes += (primary + 1 - layers.size()) * sizeof(Layer);
+        layers.resize(primary + 1);
+    }
+    if (size == 1 || primary < min_primary) {
+        min_primary = primary;
+    }
+    Layer &layer = layers[primary];
+    if (secondary >= static_cast<int>(layer.buckets.size())) {
+        array_bytes +=
+            (secondary + 1 - layer.buckets.size()) * sizeof(unique_ptr<Bucket>);
+        layer.buckets.resize(secondary + 1);
+    }
+    if (layer.size == 0 || secondary < layer.min_secondary) {
+        layer.min_secondary = secondary;
+    }
+    unique_ptr<Bucket> &bucket = layer.buckets[secondary];
+    if (!bucket) {
+        bucket = make_unique<Bucket>();
+    }
+    bucket->push_back(entry);
+    ++layer.size;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min() {
+    assert(size > 0);
+    --size;
+    if (use_map) {
+        auto it = map_buckets.begin();
+        assert(it != map_buckets.end());
+        Bucket &bucket = it->second;
+        assert(!bucket.empty());
+        Entry result = bucket.front();
+        bucket.pop_front();
+        if (bucket.empty()) {
+            map_buckets.erase(it);
+        }
+        return result;
+    }
+
+    while (layers[min_primary].size == 0) {
+        ++min_primary;
+        assert(min_primary < static_cast<int>(layers.size()));
+    }
+    Layer &layer = layers[min_primary];
+    while (!layer.buckets[layer.min_secondary]) {
+        ++layer.min_secondary;
+        assert(layer.min_secondary < static_cast<int>(layer.buckets.size()));
+    }
+    --layer.size;
+    unique_ptr<Bucket> &bucket = layer.buckets[layer.min_secondary];
+    assert(!bucket->empty());
+    Entry result = bucket->front();
+    bucket->pop_front();
+    if (bucket->empty()) {
+        bucket = nullptr;
+    }
+    if (layer.size == 0) {
+        // Release the buckets of the exhausted layer.
+        array_bytes -= layer.buckets.size() * sizeof(unique_ptr<Bucket>);
+        vector<unique_ptr<Bucket>>().swap(layer.buckets);
+        layer.min_secondary = 0;
+    }
+    return result;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    vector<Layer>().swap(layers);
+    map_buckets.clear();
+    use_map = false;
+    min_primary = 0;
+    size = 0;
+    array_bytes = 0;
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    primary_evaluator->get_path_dependent_evaluators(evals);
+    secondary_evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_evaluators(vector<Evaluator *> &evals) {
+    primary_evaluator->get_evaluators(evals);
+    secondary_evaluator->get_evaluators(evals);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    primary_evaluator->compute_batch_results(eval_contexts);
+    secondary_evaluator->compute_batch_results(eval_contexts);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // Same as the tie-breaking open list without unsafe pruning.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    return eval_context.is_evaluator_value_infinite(primary_evaluator.get()) &&
+           eval_context.is_evaluator_value_infinite(secondary_evaluator.get());
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (Evaluator *evaluator :
+         {primary_evaluator.get(), secondary_evaluator.get()}) {
+        if (eval_context.is_evaluator_value_infinite(evaluator) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    }
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(
+    const shared_ptr<AbstractTask> &task,
+    const shared_ptr<Evaluator> &primary_eval,
+    const shared_ptr<Evaluator> &secondary_eval, bool pref_only)
+    : OpenListFactory(task),
+      primary_eval(primary_eval),
+      secondary_eval(secondary_eval),
+      pref_only(pref_only) {
+}
+
+unique_ptr<StateOpenList> BucketOpenListFactory::create_state_open_list() {
+    return make_unique<BucketOpenList<StateOpenListEntry>>(
+        primary_eval, secondary_eval, pref_only);
+}
+
+unique_ptr<EdgeOpenList> BucketOpenListFactory::create_edge_open_list() {
+    return make_unique<BucketOpenList<EdgeOpenListEntry>>(
+        primary_eval, secondary_eval, pref_only);
+}
+}
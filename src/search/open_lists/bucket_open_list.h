@@ -0,0 +1,37 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+
+/*
+  Open list ordered by the values of two evaluators (lexicographically),
+  using FIFO tie-breaking. It orders entries exactly like a tie-breaking
+  open list with the same two evaluators and without unsafe pruning, but is
+  specialized for the <f, h> open list of A*.
+
+  Buckets are stored in a two-level array indexed by the two values, which
+  grows as needed. This avoids the tree lookups and the heap-allocated
+  vector keys of the tie-breaking open list. The buckets of a layer (all
+  entries with the same first value) are released once the layer is empty.
+  If a value is negative or the arrays would grow too large, the open list
+  moves all entries into a map from pairs of values to buckets and uses
+  that map from then on.
+*/
+
+namespace bucket_open_list {
+class BucketOpenListFactory : public OpenListFactory {
+    std::shared_ptr<Evaluator> primary_eval;
+    std::shared_ptr<Evaluator> secondary_eval;
+    bool pref_only;
+public:
+    BucketOpenListFactory(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::shared_ptr<Evaluator> &primary_eval,
+        const std::shared_ptr<Evaluator> &secondary_eval, bool pref_only);
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
@@ -54,6 +54,9 @@ public:
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool empty() const override;
     virtual void clear() override;
 };
@@ -125,6 +128,17 @@ void EpsilonGreedyOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void EpsilonGreedyOpenList<Entry>::get_evaluators(vector<Evaluator *> &evals) {
+    evaluator->get_evaluators(evals);
+}
+
+template<class Entry>
+void EpsilonGreedyOpenList<Entry>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    evaluator->compute_batch_results(eval_contexts);
+}
+
 template<class Entry>
 bool EpsilonGreedyOpenList<Entry>::empty() const {
     return size == 0;
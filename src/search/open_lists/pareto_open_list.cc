@@ -51,6 +51,9 @@ public:
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
@@ -197,6 +200,19 @@ void ParetoOpenList<Entry>::get_path_dependent_evaluators(
         evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void ParetoOpenList<Entry>::get_evaluators(vector<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_evaluators(evals);
+}
+
+template<class Entry>
+void ParetoOpenList<Entry>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->compute_batch_results(eval_contexts);
+}
+
 template<class Entry>
 bool ParetoOpenList<Entry>::is_dead_end(EvaluationContext &eval_context) const {
     // TODO: Document this behaviour.
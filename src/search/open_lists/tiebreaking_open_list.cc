@@ -5,6 +5,7 @@
 
 #include "../plugins/plugin.h"
 
+#include <array>
 #include <cassert>
 #include <deque>
 #include <map>
@@ -14,11 +15,29 @@
 using namespace std;
 
 namespace tiebreaking_open_list {
-template<class Entry>
+/*
+  The open list is templated on the type of the keys of its buckets. Keys
+  with up to MAX_INLINE_DIMENSION evaluator values are stored inline in a
+  std::array, so inserting an entry does not need to allocate a vector for
+  its key. Lists with more evaluators fall back to vector<int> keys. Both
+  key types are compared lexicographically, so the order is the same.
+*/
+static const size_t MAX_INLINE_DIMENSION = 4;
+
+template<size_t N>
+static void resize_key(array<int, N> &, [[maybe_unused]] size_t dimension) {
+    assert(dimension == N);
+}
+
+static void resize_key(vector<int> &key, size_t dimension) {
+    key.resize(dimension);
+}
+
+template<class Entry, class Key>
 class TieBreakingOpenList : public OpenList<Entry> {
     using Bucket = deque<Entry>;
 
-    map<const vector<int>, Bucket> buckets;
+    map<Key, Bucket> buckets;
     int size;
 
     vector<shared_ptr<Evaluator>> evaluators;
@@ -45,13 +64,16 @@ public:
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
     virtual bool is_dead_end(EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
 };
 
-template<class Entry>
-TieBreakingOpenList<Entry>::TieBreakingOpenList(
+template<class Entry, class Key>
+TieBreakingOpenList<Entry, Key>::TieBreakingOpenList(
     const vector<shared_ptr<Evaluator>> &evals, bool unsafe_pruning,
     bool pref_only)
     : OpenList<Entry>(pref_only),
@@ -60,23 +82,23 @@ TieBreakingOpenList<Entry>::TieBreakingOpenList(
       allow_unsafe_pruning(unsafe_pruning) {
 }
 
-template<class Entry>
-void TieBreakingOpenList<Entry>::do_insertion(
+template<class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size());
-    for (const shared_ptr<Evaluator> &evaluator : evaluators)
-        key.push_back(
-            eval_context.get_evaluator_value_or_infinity(evaluator.get()));
+    Key key{};
+    resize_key(key, evaluators.size());
+    for (size_t i = 0; i < evaluators.size(); ++i)
+        key[i] =
+            eval_context.get_evaluator_value_or_infinity(evaluators[i].get());
 
     buckets[key].push_back(entry);
     ++size;
 }
 
-template<class Entry>
-Entry TieBreakingOpenList<Entry>::remove_min() {
+template<class Entry, class Key>
+Entry TieBreakingOpenList<Entry, Key>::remove_min() {
     assert(size > 0);
-    typename map<const vector<int>, Bucket>::iterator it;
+    typename map<Key, Bucket>::iterator it;
     it = buckets.begin();
     assert(it != buckets.end());
     assert(!it->second.empty());
@@ -88,31 +110,44 @@ Entry TieBreakingOpenList<Entry>::remove_min() {
     return result;
 }
 
-template<class Entry>
-bool TieBreakingOpenList<Entry>::empty() const {
+template<class Entry, class Key>
+bool TieBreakingOpenList<Entry, Key>::empty() const {
     return size == 0;
 }
 
-template<class Entry>
-void TieBreakingOpenList<Entry>::clear() {
+template<class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::clear() {
     buckets.clear();
     size = 0;
 }
 
-template<class Entry>
-int TieBreakingOpenList<Entry>::dimension() const {
+template<class Entry, class Key>
+int TieBreakingOpenList<Entry, Key>::dimension() const {
     return evaluators.size();
 }
 
-template<class Entry>
-void TieBreakingOpenList<Entry>::get_path_dependent_evaluators(
+template<class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::get_path_dependent_evaluators(
     set<Evaluator *> &evals) {
     for (const shared_ptr<Evaluator> &evaluator : evaluators)
         evaluator->get_path_dependent_evaluators(evals);
 }
 
-template<class Entry>
-bool TieBreakingOpenList<Entry>::is_dead_end(
+template<class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::get_evaluators(vector<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_evaluators(evals);
+}
+
+template<class Entry, class Key>
+void TieBreakingOpenList<Entry, Key>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->compute_batch_results(eval_contexts);
+}
+
+template<class Entry, class Key>
+bool TieBreakingOpenList<Entry, Key>::is_dead_end(
     EvaluationContext &eval_context) const {
     // TODO: Properly document this behaviour.
     // If one safe heuristic detects a dead end, return true.
@@ -130,8 +165,8 @@ bool TieBreakingOpenList<Entry>::is_dead_end(
     return true;
 }
 
-template<class Entry>
-bool TieBreakingOpenList<Entry>::is_reliable_dead_end(
+template<class Entry, class Key>
+bool TieBreakingOpenList<Entry, Key>::is_reliable_dead_end(
     EvaluationContext &eval_context) const {
     for (const shared_ptr<Evaluator> &evaluator : evaluators)
         if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
@@ -140,6 +175,30 @@ bool TieBreakingOpenList<Entry>::is_reliable_dead_end(
     return false;
 }
 
+template<class Entry>
+static unique_ptr<OpenList<Entry>> create_tiebreaking_open_list(
+    const vector<shared_ptr<Evaluator>> &evals, bool unsafe_pruning,
+    bool pref_only) {
+    static_assert(MAX_INLINE_DIMENSION == 4);
+    switch (evals.size()) {
+    case 1:
+        return make_unique<TieBreakingOpenList<Entry, array<int, 1>>>(
+            evals, unsafe_pruning, pref_only);
+    case 2:
+        return make_unique<TieBreakingOpenList<Entry, array<int, 2>>>(
+            evals, unsafe_pruning, pref_only);
+    case 3:
+        return make_unique<TieBreakingOpenList<Entry, array<int, 3>>>(
+            evals, unsafe_pruning, pref_only);
+    case 4:
+        return make_unique<TieBreakingOpenList<Entry, array<int, 4>>>(
+            evals, unsafe_pruning, pref_only);
+    default:
+        return make_unique<TieBreakingOpenList<Entry, vector<int>>>(
+            evals, unsafe_pruning, pref_only);
+    }
+}
+
 TieBreakingOpenListFactory::TieBreakingOpenListFactory(
     const shared_ptr<AbstractTask> &task,
     const vector<shared_ptr<Evaluator>> &evals, bool unsafe_pruning,
@@ -152,12 +211,12 @@ TieBreakingOpenListFactory::TieBreakingOpenListFactory(
 }
 
 unique_ptr<StateOpenList> TieBreakingOpenListFactory::create_state_open_list() {
-    return make_unique<TieBreakingOpenList<StateOpenListEntry>>(
+    return create_tiebreaking_open_list<StateOpenListEntry>(
         evals, unsafe_pruning, pref_only);
 }
 
 unique_ptr<EdgeOpenList> TieBreakingOpenListFactory::create_edge_open_list() {
-    return make_unique<TieBreakingOpenList<EdgeOpenListEntry>>(
+    return create_tiebreaking_open_list<EdgeOpenListEntry>(
         evals, unsafe_pruning, pref_only);
 }
 
@@ -43,6 +43,9 @@ public:
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(
         set<Evaluator *> &evals) override;
+    virtual void get_evaluators(vector<Evaluator *> &evals) override;
+    virtual void compute_batch_results(
+        const vector<EvaluationContext *> &eval_contexts) override;
 };
 
 template<class Entry>
@@ -134,6 +137,21 @@ void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
     }
 }
 
+template<class Entry>
+void TypeBasedOpenList<Entry>::get_evaluators(vector<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
+        evaluator->get_evaluators(evals);
+    }
+}
+
+template<class Entry>
+void TypeBasedOpenList<Entry>::compute_batch_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
+        evaluator->compute_batch_results(eval_contexts);
+    }
+}
+
 TypeBasedOpenListFactory::TypeBasedOpenListFactory(
     const shared_ptr<AbstractTask> &task,
     const vector<shared_ptr<Evaluator>> &evaluators, int random_seed)
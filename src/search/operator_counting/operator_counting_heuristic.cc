@@ -4,6 +4,7 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/component_errors.h"
+#include "../utils/logging.h"
 #include "../utils/markup.h"
 #include "../utils/strings.h"
 
@@ -15,11 +16,20 @@ namespace operator_counting {
 OperatorCountingHeuristic::OperatorCountingHeuristic(
     const shared_ptr<AbstractTask> &task,
     const vector<shared_ptr<ConstraintGenerator>> &constraint_generators,
-    bool use_integer_operator_counts, lp::LPSolverType lpsolver,
-    bool cache_estimates, const string &description, utils::Verbosity verbosity)
+    bool use_integer_operator_counts, int max_cached_bases,
+    lp::LPSolverType lpsolver, bool cache_estimates, const string &description,
+    utils::Verbosity verbosity)
     : Heuristic(task, cache_estimates, description, verbosity),
       constraint_generators(constraint_generators),
-      lp_solver(lpsolver) {
+      lp_solver(lpsolver),
+      max_cached_bases(max_cached_bases),
+      cached_registry(nullptr),
+      pending_parent_id(StateID::no_state),
+      pending_state_id(StateID::no_state),
+      num_lp_solves(0),
+      num_warm_starts(0),
+      num_simplex_iterations(0),
+      lp_timer(false) {
     utils::verify_list_not_empty(
         constraint_generators, "constraint_generators");
     lp_solver.set_mip_gap(0);
@@ -39,9 +49,71 @@ OperatorCountingHeuristic::OperatorCountingHeuristic(
         generator->initialize_constraints(task, lp);
     }
     lp_solver.load_problem(lp);
+    if (max_cached_bases > 0 && log.is_at_least_normal()) {
+        log << "Warm-starting LPs from the bases of up to " << max_cached_bases
+            << " cached parent states" << endl;
+    }
+}
+
+void OperatorCountingHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    if (max_cached_bases > 0)
+        evals.insert(this);
+}
+
+void OperatorCountingHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID, const State &state) {
+    pending_parent_id = parent_state.get_id();
+    pending_state_id = state.get_id();
+}
+
+void OperatorCountingHeuristic::load_parent_basis(
+    const State &ancestor_state, StateID parent_id) {
+    if (parent_id != StateID::no_state &&
+        ancestor_state.get_registry() == cached_registry) {
+        auto it = cached_bases.find(parent_id);
+        if (it != cached_bases.end()) {
+            lp_solver.set_basis(it->second);
+            ++num_warm_starts;
+        }
+    }
+}
+
+void OperatorCountingHeuristic::cache_basis(const State &ancestor_state) {
+    if (ancestor_state.get_registry() != cached_registry) {
+        cached_bases.clear();
+        cached_states.clear();
+        cached_registry = ancestor_state.get_registry();
+    }
+    auto [it, inserted] =
+        cached_bases.try_emplace(ancestor_state.get_id(), lp::LPBasis());
+    if (!lp_solver.get_basis(it->second)) {
+        if (inserted)
+            cached_bases.erase(it);
+        return;
+    }
+    if (!inserted) {
+        // The state is reevaluated, e.g. after its cache entry was dirtied.
+        return;
+    }
+    cached_states.push_back(ancestor_state.get_id());
+    if (static_cast<int>(cached_states.size()) > max_cached_bases) {
+        cached_bases.erase(cached_states.front());
+        cached_states.pop_front();
+    }
 }
 
 int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
+    /*
+      Only the state reached by the last reported transition can start from
+      the basis of its parent. Forget the transition right away, so that it
+      is also discarded if the state turns out to be a dead end.
+    */
+    StateID parent_id = ancestor_state.get_id() == pending_state_id
+                            ? pending_parent_id
+                            : StateID::no_state;
+    pending_state_id = StateID::no_state;
+
     State state = convert_ancestor_state(ancestor_state);
     assert(!lp_solver.has_temporary_constraints());
     for (const auto &generator : constraint_generators) {
@@ -51,12 +123,20 @@ int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
             return DEAD_END;
         }
     }
+    if (max_cached_bases > 0)
+        load_parent_basis(ancestor_state, parent_id);
     int result;
+    lp_timer.resume();
     lp_solver.solve();
+    lp_timer.stop();
+    ++num_lp_solves;
+    num_simplex_iterations += lp_solver.get_num_iterations();
     if (lp_solver.has_optimal_solution()) {
         double epsilon = 0.01;
         double objective_value = lp_solver.get_objective_value();
         result = static_cast<int>(ceil(objective_value - epsilon));
+        if (max_cached_bases > 0)
+            cache_basis(ancestor_state);
     } else {
         result = DEAD_END;
     }
@@ -64,6 +144,25 @@ int OperatorCountingHeuristic::compute_heuristic(const State &ancestor_state) {
     return result;
 }
 
+void OperatorCountingHeuristic::print_statistics() const {
+    if (log.is_at_least_normal()) {
+        log << "LP solves: " << num_lp_solves << endl;
+        if (max_cached_bases > 0) {
+            log << "LP solves started from the parent's basis: "
+                << num_warm_starts << endl;
+        }
+        log << "Simplex iterations: " << num_simplex_iterations << endl;
+        log << "Time for solving LPs: " << lp_timer << endl;
+        if (num_lp_solves > 0) {
+            log << "Average simplex iterations per LP solve: "
+                << static_cast<double>(num_simplex_iterations) / num_lp_solves
+                << endl;
+            log << "Average time per LP solve: "
+                << lp_timer() / num_lp_solves << "s" << endl;
+        }
+    }
+}
+
 class OperatorCountingHeuristicFeature
     : public plugins::TypedFeature<TaskIndependentEvaluator> {
 public:
@@ -98,6 +197,14 @@ public:
             "computationally expensive. Turning this option on can thus drastically "
             "increase the runtime.",
             "false");
+        add_option<int>(
+            "max_cached_bases",
+            "maximum number of states whose simplex bases are cached to solve "
+            "the LPs of their successors starting from them (set to 0 to start "
+            "from the basis of the previously solved LP). Caching bases makes "
+            "the heuristic path-dependent. It has no effect with "
+            "use_integer_operator_counts=true.",
+            "0", plugins::Bounds("0", "infinity"));
         lp::add_lp_solver_option_to_feature(*this);
         add_heuristic_options_to_feature(*this, "operatorcounting");
 
@@ -127,6 +234,7 @@ public:
             opts.get_list<shared_ptr<TaskIndependentConstraintGenerator>>(
                 "constraint_generators"),
             opts.get<bool>("use_integer_operator_counts"),
+            opts.get<int>("max_cached_bases"),
             lp::get_lp_solver_arguments_from_options(opts),
             get_heuristic_arguments_from_options(opts));
     }
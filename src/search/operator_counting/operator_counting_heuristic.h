@@ -4,16 +4,45 @@
 #include "../heuristic.h"
 
 #include "../lp/lp_solver.h"
+#include "../utils/hash.h"
+#include "../utils/timer.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
+class StateRegistry;
+
 namespace operator_counting {
 class ConstraintGenerator;
 
+/*
+  With max_cached_bases > 0, the simplex bases of the most recently
+  evaluated states are cached, and the LP of a state is solved starting
+  from the basis of its parent instead of the basis of the previously
+  solved LP.
+*/
 class OperatorCountingHeuristic : public Heuristic {
     std::vector<std::shared_ptr<ConstraintGenerator>> constraint_generators;
     lp::LPSolver lp_solver;
+    const int max_cached_bases;
+
+    const StateRegistry *cached_registry;
+    utils::HashMap<StateID, lp::LPBasis> cached_bases;
+    // Cached states in insertion order, used for evicting old entries.
+    std::deque<StateID> cached_states;
+
+    // Transition reported last, used to look up the parent's basis.
+    StateID pending_parent_id;
+    StateID pending_state_id;
+
+    int num_lp_solves;
+    int num_warm_starts;
+    long long num_simplex_iterations;
+    utils::Timer lp_timer;
+
+    void load_parent_basis(const State &ancestor_state, StateID parent_id);
+    void cache_basis(const State &ancestor_state);
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
@@ -21,9 +50,16 @@ public:
         const std::shared_ptr<AbstractTask> &task,
         const std::vector<std::shared_ptr<ConstraintGenerator>>
             &constraint_generators,
-        bool use_integer_operator_counts, lp::LPSolverType lpsolver,
-        bool cache_estimates, const std::string &description,
-        utils::Verbosity verbosity);
+        bool use_integer_operator_counts, int max_cached_bases,
+        lp::LPSolverType lpsolver, bool cache_estimates,
+        const std::string &description, utils::Verbosity verbosity);
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
+    virtual void print_statistics() const override;
 };
 }
 
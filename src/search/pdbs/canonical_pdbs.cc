@@ -41,4 +41,41 @@ int CanonicalPDBs::get_value(const State &state) const {
     }
     return max_h;
 }
+
+void CanonicalPDBs::get_values(
+    span<const int> state_values, int num_variables,
+    span<int> values) const {
+    assert(!pattern_cliques->empty());
+    // Evaluate one PDB for all states at a time to keep it in the cache.
+    int num_states = values.size();
+    vector<int> h_values(pdbs->size() * num_states);
+    for (size_t pdb_index = 0; pdb_index < pdbs->size(); ++pdb_index) {
+        (*pdbs)[pdb_index]->get_values(
+            state_values, num_variables,
+            span<int>(h_values).subspan(pdb_index * num_states, num_states));
+    }
+    for (int i = 0; i < num_states; ++i) {
+        bool is_dead_end = false;
+        for (size_t pdb_index = 0; pdb_index < pdbs->size(); ++pdb_index) {
+            if (h_values[pdb_index * num_states + i] ==
+                numeric_limits<int>::max()) {
+                is_dead_end = true;
+                break;
+            }
+        }
+        if (is_dead_end) {
+            values[i] = numeric_limits<int>::max();
+            continue;
+        }
+        int max_h = 0;
+        for (const PatternClique &clique : *pattern_cliques) {
+            int clique_h = 0;
+            for (PatternID pdb_index : clique) {
+                clique_h += h_values[pdb_index * num_states + i];
+            }
+            max_h = max(max_h, clique_h);
+        }
+        values[i] = max_h;
+    }
+}
 }
@@ -4,6 +4,7 @@
 #include "types.h"
 
 #include <memory>
+#include <span>
 
 class State;
 
@@ -19,6 +20,10 @@ public:
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
+    // See PatternDatabase::get_values.
+    void get_values(
+        std::span<const int> state_values, int num_variables,
+        std::span<int> values) const;
 };
 }
 
@@ -17,7 +17,8 @@ namespace pdbs {
 static CanonicalPDBs get_canonical_pdbs(
     const shared_ptr<AbstractTask> &task,
     const shared_ptr<PatternCollectionGenerator> &pattern_generator,
-    double max_time_dominance_pruning, utils::LogProxy &log) {
+    double max_time_dominance_pruning, int num_threads,
+    utils::LogProxy &log) {
     utils::Timer timer;
     if (log.is_at_least_normal()) {
         log << "Initializing canonical PDB heuristic..." << endl;
@@ -31,7 +32,8 @@ static CanonicalPDBs get_canonical_pdbs(
       computed before) so that their computation is not taken into account
       for dominance pruning time.
     */
-    shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
+    shared_ptr<PDBCollection> pdbs =
+        pattern_collection_info.get_pdbs(num_threads);
     shared_ptr<vector<PatternClique>> pattern_cliques =
         pattern_collection_info.get_pattern_cliques();
 
@@ -59,11 +61,11 @@ static CanonicalPDBs get_canonical_pdbs(
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(
     const shared_ptr<AbstractTask> &task,
     const shared_ptr<PatternCollectionGenerator> &patterns,
-    double max_time_dominance_pruning, bool cache_estimates,
+    double max_time_dominance_pruning, int num_threads, bool cache_estimates,
     const string &description, utils::Verbosity verbosity)
     : Heuristic(task, cache_estimates, description, verbosity),
-      canonical_pdbs(
-          get_canonical_pdbs(task, patterns, max_time_dominance_pruning, log)) {
+      canonical_pdbs(get_canonical_pdbs(
+          task, patterns, max_time_dominance_pruning, num_threads, log)) {
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const State &ancestor_state) {
@@ -76,6 +78,18 @@ int CanonicalPDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     }
 }
 
+bool CanonicalPDBsHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    canonical_pdbs.get_values(
+        convert_ancestor_state_batch(ancestor_states),
+        task_proxy.get_variables().size(), values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max())
+            h = DEAD_END;
+    }
+    return true;
+}
+
 void add_canonical_pdbs_options_to_feature(plugins::Feature &feature) {
     feature.add_option<double>(
         "max_time_dominance_pruning",
@@ -84,11 +98,18 @@ void add_canonical_pdbs_options_to_feature(plugins::Feature &feature) {
         "and additive subsets that will never contribute to the heuristic "
         "value because there are dominating subsets in the collection.",
         "infinity", plugins::Bounds("0.0", "infinity"));
+    feature.add_option<int>(
+        "threads",
+        "number of threads used to compute the PDBs of the pattern "
+        "collection (if the pattern generator does not compute them)",
+        "1", plugins::Bounds("1", "infinity"));
 }
 
-tuple<double> get_canonical_pdbs_arguments_from_options(
+tuple<double, int> get_canonical_pdbs_arguments_from_options(
     const plugins::Options &opts) {
-    return make_tuple(opts.get<double>("max_time_dominance_pruning"));
+    return make_tuple(
+        opts.get<double>("max_time_dominance_pruning"),
+        opts.get<int>("threads"));
 }
 
 class CanonicalPDBsHeuristicFeature
@@ -17,17 +17,21 @@ class CanonicalPDBsHeuristic : public Heuristic {
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 
 public:
     CanonicalPDBsHeuristic(
         const std::shared_ptr<AbstractTask> &task,
         const std::shared_ptr<PatternCollectionGenerator> &patterns,
-        double max_time_dominance_pruning, bool cache_estimates,
+        double max_time_dominance_pruning, int num_threads,
+        bool cache_estimates,
         const std::string &description, utils::Verbosity verbosity);
 };
 
 void add_canonical_pdbs_options_to_feature(plugins::Feature &feature);
-std::tuple<double> get_canonical_pdbs_arguments_from_options(
+std::tuple<double, int> get_canonical_pdbs_arguments_from_options(
     const plugins::Options &opts);
 }
 
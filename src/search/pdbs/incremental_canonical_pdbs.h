@@ -37,7 +37,8 @@ public:
 
     /* Returns a list of pattern cliques that would be additive to the new
        pattern. Detailed documentation in max_additive_pdb_sets.h */
-    std::vector<PatternClique> get_pattern_cliques(const Pattern &new_pattern);
+    std::vector<PatternClique> get_pattern_cliques(
+        const Pattern &new_pattern) const;
 
     int get_value(const State &state) const;
 
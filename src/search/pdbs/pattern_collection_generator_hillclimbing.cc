@@ -18,6 +18,7 @@
 #include "../utils/math.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
+#include "../utils/thread_pool.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -117,7 +118,8 @@ static vector<vector<int>> compute_relevant_neighbours(
 PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(
     const shared_ptr<AbstractTask> &task, int pdb_max_size,
     int collection_max_size, int num_samples, int min_improvement,
-    double max_time, int random_seed, utils::Verbosity verbosity)
+    double max_time, int random_seed, int num_threads,
+    utils::Verbosity verbosity)
     : PatternCollectionGenerator(task, verbosity),
       pdb_max_size(pdb_max_size),
       collection_max_size(collection_max_size),
@@ -125,6 +127,7 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(
       min_improvement(min_improvement),
       max_time(max_time),
       rng(utils::get_rng(random_seed)),
+      num_threads(num_threads),
       num_rejected(0),
       hill_climbing_timer(nullptr) {
     utils::verify_argument(
@@ -138,7 +141,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -160,20 +163,23 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                 if (!generated_patterns.count(new_pattern)) {
                     /*
                       If we haven't seen this pattern before, generate a PDB
-                      for it and add it to candidate_pdbs if its size does not
-                      surpass the size limit.
+                      for it (see below) and add it to candidate_pdbs.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        compute_pdb(task_proxy, new_pattern));
-                    max_pdb_size =
-                        max(max_pdb_size, candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &new_pdb :
+         compute_pdbs(task_proxy, new_patterns, *thread_pool)) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(move(new_pdb));
+    }
     return max_pdb_size;
 }
 
@@ -207,11 +213,8 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     int improvement = 0;
     int best_pdb_index = -1;
 
-    // Iterate over all candidates and search for the best improving pattern/pdb
+    vector<int> candidate_ids;
     for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
         const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
         if (!pdb) {
             /* candidate pattern is too large or has already been added to
@@ -227,30 +230,47 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
             candidate_pdbs[i] = nullptr;
             continue;
         }
+        candidate_ids.push_back(i);
+    }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
+    /*
+      Calculate the "counting approximation" for all remaining candidates and
+      sample states: count the number of samples for which the current pattern
+      collection heuristic would be improved if the new pattern was included
+      into it. Each candidate is evaluated by a single thread.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    vector<int> counts(candidate_ids.size());
+    const PDBCollection &pdbs = *current_pdbs->get_pattern_databases();
+    thread_pool->run(candidate_ids.size(), [&](int task_index, int) {
+        if (hill_climbing_timer->is_expired())
+            throw HillClimbingTimeout();
+
+        const PatternDatabase &pdb = *candidate_pdbs[candidate_ids[task_index]];
         vector<PatternClique> pattern_cliques =
-            current_pdbs->get_pattern_cliques(pdb->get_pattern());
+            current_pdbs->get_pattern_cliques(pdb.get_pattern());
+        int count = 0;
         for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
             const State &sample = samples[sample_id];
             assert(utils::in_bounds(sample_id, samples_h_values));
             int h_collection = samples_h_values[sample_id];
             if (is_heuristic_improved(
-                    *pdb, sample, h_collection,
-                    *current_pdbs->get_pattern_databases(), pattern_cliques)) {
+                    pdb, sample, h_collection, pdbs, pattern_cliques)) {
                 ++count;
             }
         }
+        counts[task_index] = count;
+    });
+
+    // Search for the best improving pattern/pdb in the order of candidates.
+    for (size_t task_index = 0; task_index < candidate_ids.size();
+         ++task_index) {
+        int i = candidate_ids[task_index];
+        int count = counts[task_index];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -266,7 +286,8 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
 
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     const PatternDatabase &pdb, const State &sample, int h_collection,
-    const PDBCollection &pdbs, const vector<PatternClique> &pattern_cliques) {
+    const PDBCollection &pdbs,
+    const vector<PatternClique> &pattern_cliques) const {
     const vector<int> &sample_data = sample.get_unpacked_values();
     // h_pattern: h-value of the new pattern
     int h_pattern = pdb.get_value(sample_data);
@@ -306,6 +327,7 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
 void PatternCollectionGeneratorHillclimbing::hill_climbing(
     const TaskProxy &task_proxy) {
     hill_climbing_timer = new utils::CountdownTimer(max_time);
+    thread_pool = make_unique<utils::ThreadPool>(num_threads);
 
     if (log.is_at_least_normal()) {
         log << "Average operator cost: "
@@ -367,9 +389,11 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             samples.clear();
             samples_h_values.clear();
             sample_states(sampler, init_h, samples);
-            for (const State &sample : samples) {
-                samples_h_values.push_back(current_pdbs->get_value(sample));
-            }
+            samples_h_values.resize(samples.size());
+            thread_pool->run(samples.size(), [&](int sample_id, int) {
+                samples_h_values[sample_id] =
+                    current_pdbs->get_value(samples[sample_id]);
+            });
 
             pair<int, int> improvement_and_index = find_best_improving_pdb(
                 samples, samples_h_values, candidate_pdbs);
@@ -430,6 +454,7 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
     delete hill_climbing_timer;
     hill_climbing_timer = nullptr;
+    thread_pool = nullptr;
 }
 
 string PatternCollectionGeneratorHillclimbing::name() const {
@@ -593,6 +618,12 @@ public:
             "in the following paper:" +
             paper_references());
         add_hillclimbing_options_to_feature(*this);
+        add_option<int>(
+            "threads",
+            "number of threads used to compute candidate PDBs and to evaluate "
+            "them on the samples. The resulting pattern collection does not "
+            "depend on the number of threads.",
+            "1", plugins::Bounds("1", "infinity"));
         add_generator_options_to_feature(*this);
     }
 
@@ -601,6 +632,7 @@ public:
         return components::make_auto_task_independent_component<
             PatternCollectionGeneratorHillclimbing, PatternCollectionGenerator>(
             get_hillclimbing_arguments_from_options(opts),
+            opts.get<int>("threads"),
             get_generator_arguments_from_options(opts));
     }
 };
@@ -627,7 +659,8 @@ public:
 
         add_hillclimbing_options_to_feature(*this);
         /*
-          Add, possibly among others, the options for dominance pruning.
+          Add, possibly among others, the options for dominance pruning and
+          the number of threads, which we also use for hill climbing.
           Note that using dominance pruning during hill climbing could lead to
           fewer discovered patterns and pattern collections. A dominated pattern
           (or pattern collection) might no longer be dominated after more
@@ -654,11 +687,12 @@ public:
                 PatternCollectionGeneratorHillclimbing,
                 PatternCollectionGenerator>(
                 get_hillclimbing_arguments_from_options(opts),
+                opts.get<int>("threads"),
                 get_generator_arguments_from_options(opts));
 
         return components::make_auto_task_independent_component<
             CanonicalPDBsHeuristic, Evaluator>(
-            pgh, opts.get<double>("max_time_dominance_pruning"),
+            pgh, get_canonical_pdbs_arguments_from_options(opts),
             get_heuristic_arguments_from_options(opts));
     }
 };
@@ -14,6 +14,7 @@
 namespace utils {
 class CountdownTimer;
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace sampling {
@@ -37,12 +38,15 @@ class PatternCollectionGeneratorHillclimbing
     const int min_improvement;
     const double max_time;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
+    const int num_threads;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
 
     // for stats only
     int num_rejected;
     utils::CountdownTimer *hill_climbing_timer;
+    // Only exists while hill climbing runs.
+    std::unique_ptr<utils::ThreadPool> thread_pool;
 
     /*
       For the given PDB, all possible extensions of its pattern by one
@@ -52,6 +56,7 @@ class PatternCollectionGeneratorHillclimbing
       size limit, then the PDB is built and added to candidate_pdbs.
 
       The method returns the size of the largest PDB added to candidate_pdbs.
+      The new PDBs are computed in parallel, but added in a fixed order.
     */
     int generate_candidate_pdbs(
         const TaskProxy &task_proxy,
@@ -76,7 +81,9 @@ class PatternCollectionGeneratorHillclimbing
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      the index of the best pdb in candidate_pdbs. The candidates are evaluated
+      in parallel, but ties are broken in favor of the first candidate, so the
+      result does not depend on the number of threads.
     */
     std::pair<int, int> find_best_improving_pdb(
         const std::vector<State> &samples,
@@ -92,7 +99,7 @@ class PatternCollectionGeneratorHillclimbing
     bool is_heuristic_improved(
         const PatternDatabase &pdb, const State &sample, int h_collection,
         const PDBCollection &pdbs,
-        const std::vector<PatternClique> &pattern_cliques);
+        const std::vector<PatternClique> &pattern_cliques) const;
 
     /*
       This is the core algorithm of this class. The initial PDB collection
@@ -132,7 +139,8 @@ public:
     PatternCollectionGeneratorHillclimbing(
         const std::shared_ptr<AbstractTask> &task, int pdb_max_size,
         int collection_max_size, int num_samples, int min_improvement,
-        double max_time, int random_seed, utils::Verbosity verbosity);
+        double max_time, int random_seed, int num_threads,
+        utils::Verbosity verbosity);
 };
 
 extern void add_hillclimbing_options_to_feature(plugins::Feature &feature);
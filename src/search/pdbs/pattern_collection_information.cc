@@ -55,18 +55,15 @@ bool PatternCollectionInformation::information_is_valid() const {
     return true;
 }
 
-void PatternCollectionInformation::create_pdbs_if_missing() {
+void PatternCollectionInformation::create_pdbs_if_missing(int num_threads) {
     assert(patterns);
     if (!pdbs) {
         utils::Timer timer;
         if (log.is_at_least_normal()) {
             log << "Computing PDBs for pattern collection..." << endl;
         }
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb = compute_pdb(task_proxy, pattern);
-            pdbs->push_back(pdb);
-        }
+        pdbs = make_shared<PDBCollection>(
+            compute_pdbs(task_proxy, *patterns, num_threads));
         if (log.is_at_least_normal()) {
             log << "Done computing PDBs for pattern collection: " << timer
                 << endl;
@@ -108,8 +105,9 @@ PatternCollectionInformation::get_patterns() const {
     return patterns;
 }
 
-shared_ptr<PDBCollection> PatternCollectionInformation::get_pdbs() {
-    create_pdbs_if_missing();
+shared_ptr<PDBCollection> PatternCollectionInformation::get_pdbs(
+    int num_threads) {
+    create_pdbs_if_missing(num_threads);
     return pdbs;
 }
 
@@ -31,7 +31,7 @@ class PatternCollectionInformation {
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
     utils::LogProxy &log;
 
-    void create_pdbs_if_missing();
+    void create_pdbs_if_missing(int num_threads);
     void create_pattern_cliques_if_missing();
 
     bool information_is_valid() const;
@@ -51,7 +51,11 @@ public:
     }
 
     std::shared_ptr<PatternCollection> get_patterns() const;
-    std::shared_ptr<PDBCollection> get_pdbs();
+    /*
+      Return the PDBs of the pattern collection. If they have not been
+      computed yet, compute them with the given number of threads.
+    */
+    std::shared_ptr<PDBCollection> get_pdbs(int num_threads = 1);
     std::shared_ptr<std::vector<PatternClique>> get_pattern_cliques();
 };
 }
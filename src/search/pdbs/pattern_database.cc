@@ -37,7 +37,7 @@ Projection::Projection(const TaskProxy &task_proxy, const Pattern &pattern)
     }
 }
 
-int Projection::rank(const vector<int> &state) const {
+int Projection::rank(span<const int> state) const {
     size_t index = 0;
     for (size_t i = 0; i < pattern.size(); ++i) {
         index += hash_multipliers[i] * state[pattern[i]];
@@ -59,6 +59,21 @@ int PatternDatabase::get_value(const vector<int> &state) const {
     return distances[projection.rank(state)];
 }
 
+void PatternDatabase::get_values(
+    span<const int> state_values, int num_variables,
+    span<int> values) const {
+    assert(state_values.size() == values.size() * num_variables);
+    /*
+      Ranking all states before looking up their distances allows the
+      lookups in the (possibly large) distance table to overlap.
+    */
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = projection.rank(
+            state_values.subspan(i * num_variables, num_variables));
+    for (int &value : values)
+        value = distances[value];
+}
+
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
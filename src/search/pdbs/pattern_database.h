@@ -5,6 +5,7 @@
 
 #include "../task_proxy.h"
 
+#include <span>
 #include <vector>
 
 namespace pdbs {
@@ -17,7 +18,7 @@ public:
     Projection(const TaskProxy &task_proxy, const Pattern &pattern);
 
     // Compute the hash index (aka. the rank) of the given concrete state.
-    int rank(const std::vector<int> &state) const;
+    int rank(std::span<const int> state) const;
 
     /*
       Compute the value of a given variable in the abstract state given as
@@ -49,6 +50,13 @@ class PatternDatabase {
 public:
     PatternDatabase(Projection &&projection, std::vector<int> &&distances);
     int get_value(const std::vector<int> &state) const;
+    /*
+      Store the values of several states in values. The states are given
+      row by row in state_values, with num_variables values per state.
+    */
+    void get_values(
+        std::span<const int> state_values, int num_variables,
+        std::span<int> values) const;
 
     const Pattern &get_pattern() const {
         return projection.get_pattern();
@@ -8,8 +8,10 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/math.h"
 #include "../utils/rng.h"
+#include "../utils/thread_pool.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <limits>
 #include <vector>
@@ -17,6 +19,16 @@
 using namespace std;
 
 namespace pdbs {
+/*
+  We only compute distances with a parallel breadth-first search if the
+  projection has at least this many abstract states. For smaller projections,
+  synchronizing the threads after each layer costs more than it saves.
+*/
+static const int MIN_ABSTRACT_STATES_FOR_PARALLEL_SEARCH = 1 << 17;
+
+// Number of abstract states a thread processes at once.
+static const int PARALLEL_SEARCH_CHUNK_SIZE = 1024;
+
 class PatternDatabaseFactory {
     const TaskProxy &task_proxy;
     VariablesProxy variables;
@@ -83,8 +95,24 @@ class PatternDatabaseFactory {
     */
     bool is_goal_state(int state_index) const;
 
+    /*
+      Return the cost of all abstract operators if they all have the same
+      positive cost, or -1 otherwise.
+    */
+    int get_uniform_operator_cost() const;
+
     void compute_distances(const MatchTree &match_tree, bool compute_plan);
 
+    /*
+      Compute the same distances as compute_distances() for projections whose
+      abstract operators all have the given positive cost. Instead of
+      Dijkstra's algorithm, we use a layered breadth-first search that
+      regresses all states of a layer in parallel.
+    */
+    void compute_distances_in_parallel(
+        const MatchTree &match_tree, int operator_cost,
+        utils::ThreadPool &thread_pool);
+
     void compute_plan(
         const MatchTree &match_tree,
         const shared_ptr<utils::RandomNumberGenerator> &rng,
@@ -95,7 +123,8 @@ public:
         const vector<int> &operator_costs = vector<int>(),
         bool compute_plan = false,
         const shared_ptr<utils::RandomNumberGenerator> &rng = nullptr,
-        bool compute_wildcard_plan = false);
+        bool compute_wildcard_plan = false,
+        utils::ThreadPool *thread_pool = nullptr);
     ~PatternDatabaseFactory() = default;
 
     shared_ptr<PatternDatabase> extract_pdb() {
@@ -331,6 +360,98 @@ void PatternDatabaseFactory::compute_distances(
     }
 }
 
+int PatternDatabaseFactory::get_uniform_operator_cost() const {
+    if (abstract_ops.empty()) {
+        return -1;
+    }
+    int cost = abstract_ops.front().get_cost();
+    for (const AbstractOperator &op : abstract_ops) {
+        if (op.get_cost() != cost) {
+            return -1;
+        }
+    }
+    return cost > 0 ? cost : -1;
+}
+
+void PatternDatabaseFactory::compute_distances_in_parallel(
+    const MatchTree &match_tree, int operator_cost,
+    utils::ThreadPool &thread_pool) {
+    assert(operator_cost > 0);
+    int num_states = projection.get_num_abstract_states();
+    int num_threads = thread_pool.get_num_threads();
+    distances.resize(num_states);
+    // States whose distance was set in the last layer, one vector per thread.
+    vector<vector<int>> new_states_by_thread(num_threads);
+
+    // Initialize distances and collect goal states.
+    int num_chunks =
+        (num_states + PARALLEL_SEARCH_CHUNK_SIZE - 1) /
+        PARALLEL_SEARCH_CHUNK_SIZE;
+    thread_pool.run(num_chunks, [&](int chunk, int thread_id) {
+        int begin = chunk * PARALLEL_SEARCH_CHUNK_SIZE;
+        int end = min(num_states, begin + PARALLEL_SEARCH_CHUNK_SIZE);
+        for (int state_index = begin; state_index < end; ++state_index) {
+            if (is_goal_state(state_index)) {
+                distances[state_index] = 0;
+                new_states_by_thread[thread_id].push_back(state_index);
+            } else {
+                distances[state_index] = numeric_limits<int>::max();
+            }
+        }
+    });
+
+    vector<int> layer;
+    vector<vector<int>> applicable_ops_by_thread(num_threads);
+    for (int distance = operator_cost;; distance += operator_cost) {
+        layer.clear();
+        for (vector<int> &new_states : new_states_by_thread) {
+            layer.insert(layer.end(), new_states.begin(), new_states.end());
+            new_states.clear();
+        }
+        if (layer.empty()) {
+            break;
+        }
+        assert(distance > 0);
+
+        /*
+          Several threads may reach the same predecessor, but only the one
+          that changes its distance from infinity adds it to the next layer.
+          Since all predecessors found in this layer get the same distance,
+          the result does not depend on the order in which threads run.
+        */
+        num_chunks = (static_cast<int>(layer.size()) +
+                      PARALLEL_SEARCH_CHUNK_SIZE - 1) /
+                     PARALLEL_SEARCH_CHUNK_SIZE;
+        thread_pool.run(num_chunks, [&](int chunk, int thread_id) {
+            vector<int> &applicable_operator_ids =
+                applicable_ops_by_thread[thread_id];
+            vector<int> &new_states = new_states_by_thread[thread_id];
+            size_t begin = static_cast<size_t>(chunk) *
+                           PARALLEL_SEARCH_CHUNK_SIZE;
+            size_t end = min(layer.size(), begin + PARALLEL_SEARCH_CHUNK_SIZE);
+            for (size_t i = begin; i < end; ++i) {
+                int state_index = layer[i];
+                applicable_operator_ids.clear();
+                match_tree.get_applicable_operator_ids(
+                    state_index, applicable_operator_ids);
+                for (int op_id : applicable_operator_ids) {
+                    int predecessor =
+                        state_index + abstract_ops[op_id].get_hash_effect();
+                    atomic_ref<int> predecessor_distance(
+                        distances[predecessor]);
+                    int old_distance = numeric_limits<int>::max();
+                    if (predecessor_distance.load(memory_order_relaxed) ==
+                            old_distance &&
+                        predecessor_distance.compare_exchange_strong(
+                            old_distance, distance, memory_order_relaxed)) {
+                        new_states.push_back(predecessor);
+                    }
+                }
+            }
+        });
+    }
+}
+
 void PatternDatabaseFactory::compute_plan(
     const MatchTree &match_tree,
     const shared_ptr<utils::RandomNumberGenerator> &rng,
@@ -397,7 +518,7 @@ PatternDatabaseFactory::PatternDatabaseFactory(
     const TaskProxy &task_proxy, const Pattern &pattern,
     const vector<int> &operator_costs, bool compute_plan,
     const shared_ptr<utils::RandomNumberGenerator> &rng,
-    bool compute_wildcard_plan)
+    bool compute_wildcard_plan, utils::ThreadPool *thread_pool)
     : task_proxy(task_proxy),
       variables(task_proxy.get_variables()),
       projection(task_proxy, pattern) {
@@ -408,7 +529,16 @@ PatternDatabaseFactory::PatternDatabaseFactory(
     compute_abstract_operators(operator_costs);
     unique_ptr<MatchTree> match_tree = compute_match_tree();
     compute_abstract_goals();
-    compute_distances(*match_tree, compute_plan);
+    int uniform_operator_cost = get_uniform_operator_cost();
+    if (thread_pool && thread_pool->get_num_threads() > 1 && !compute_plan &&
+        uniform_operator_cost > 0 &&
+        projection.get_num_abstract_states() >=
+            MIN_ABSTRACT_STATES_FOR_PARALLEL_SEARCH) {
+        compute_distances_in_parallel(
+            *match_tree, uniform_operator_cost, *thread_pool);
+    } else {
+        compute_distances(*match_tree, compute_plan);
+    }
 
     if (compute_plan) {
         this->compute_plan(*match_tree, rng, compute_wildcard_plan);
@@ -434,4 +564,61 @@ compute_pdb_and_plan(
         task_proxy, pattern, operator_costs, true, rng, compute_wildcard_plan);
     return {pdb_factory.extract_pdb(), pdb_factory.extract_wildcard_plan()};
 }
+
+PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int num_threads,
+    const function<vector<int>(int)> &get_operator_costs) {
+    assert(num_threads >= 1);
+    utils::ThreadPool thread_pool(num_threads);
+    return compute_pdbs(task_proxy, patterns, thread_pool, get_operator_costs);
+}
+
+PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    utils::ThreadPool &thread_pool,
+    const function<vector<int>(int)> &get_operator_costs) {
+    int num_threads = thread_pool.get_num_threads();
+    PDBCollection pdbs(patterns.size());
+    auto compute = [&](int pattern_id, utils::ThreadPool *pool) {
+        vector<int> operator_costs;
+        if (get_operator_costs) {
+            operator_costs = get_operator_costs(pattern_id);
+        }
+        PatternDatabaseFactory pdb_factory(
+            task_proxy, patterns[pattern_id], operator_costs, false, nullptr,
+            false, pool);
+        pdbs[pattern_id] = pdb_factory.extract_pdb();
+    };
+
+    /*
+      Large PDBs are computed one after the other, each using all threads.
+      All other PDBs are computed concurrently, each in a single thread.
+    */
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<int> small_pattern_ids;
+    for (size_t pattern_id = 0; pattern_id < patterns.size(); ++pattern_id) {
+        int num_states = 1;
+        bool is_large = false;
+        for (int var : patterns[pattern_id]) {
+            int domain_size = variables[var].get_domain_size();
+            if (!utils::is_product_within_limit(
+                    num_states, domain_size,
+                    MIN_ABSTRACT_STATES_FOR_PARALLEL_SEARCH)) {
+                is_large = true;
+                break;
+            }
+            num_states *= domain_size;
+        }
+        if (num_threads > 1 && is_large) {
+            compute(pattern_id, &thread_pool);
+        } else {
+            small_pattern_ids.push_back(pattern_id);
+        }
+    }
+    thread_pool.run(small_pattern_ids.size(), [&](int task_index, int) {
+        compute(small_pattern_ids[task_index], nullptr);
+    });
+    return pdbs;
+}
 }
@@ -5,12 +5,14 @@
 
 #include "../task_proxy.h"
 
+#include <functional>
 #include <memory>
 #include <tuple>
 #include <vector>
 
 namespace utils {
 class RandomNumberGenerator;
+class ThreadPool;
 }
 
 namespace pdbs {
@@ -49,6 +51,27 @@ compute_pdb_and_plan(
     const std::vector<int> &operator_costs = std::vector<int>(),
     const std::shared_ptr<utils::RandomNumberGenerator> &rng = nullptr,
     bool compute_wildcard_plan = false);
+
+/*
+  Compute a PDB for each of the given patterns like compute_pdb() above, using
+  the given number of threads. PDBs of small patterns are computed
+  concurrently. For large patterns with uniform positive operator costs, the
+  threads cooperate on a single PDB.
+
+  If get_operator_costs is given, it is called with the index of each pattern
+  and must return the operator costs for this pattern as described for
+  compute_pdb(). It may be called concurrently from several threads.
+*/
+extern PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int num_threads,
+    const std::function<std::vector<int>(int)> &get_operator_costs = nullptr);
+
+// Like compute_pdbs() above, but use the threads of the given pool.
+extern PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    utils::ThreadPool &thread_pool,
+    const std::function<std::vector<int>(int)> &get_operator_costs = nullptr);
 }
 
 #endif
@@ -27,13 +27,24 @@ PDBHeuristic::PDBHeuristic(
 }
 
 int PDBHeuristic::compute_heuristic(const State &ancestor_state) {
-    State state = convert_ancestor_state(ancestor_state);
-    int h = pdb->get_value(state.get_unpacked_values());
+    int h = pdb->get_value(convert_ancestor_state_values(ancestor_state));
     if (h == numeric_limits<int>::max())
         return DEAD_END;
     return h;
 }
 
+bool PDBHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    pdb->get_values(
+        convert_ancestor_state_batch(ancestor_states),
+        task_proxy.get_variables().size(), values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max())
+            h = DEAD_END;
+    }
+    return true;
+}
+
 static basic_string<char> paper_references() {
     return utils::format_conference_reference(
                {"Stefan Edelkamp"}, "Planning with Pattern Databases",
@@ -13,6 +13,9 @@ class PDBHeuristic : public Heuristic {
     std::shared_ptr<PatternDatabase> pdb;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 public:
     /*
       Important: It is assumed that the pattern (passed via
@@ -8,6 +8,7 @@
 
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -17,27 +18,38 @@ using namespace std;
 
 namespace pdbs {
 ZeroOnePDBs::ZeroOnePDBs(
-    const TaskProxy &task_proxy, const PatternCollection &patterns) {
-    vector<int> remaining_operator_costs;
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int num_threads) {
+    /*
+      Each operator keeps its cost for the first pattern it is relevant for
+      and costs 0 for all later patterns (action cost partitioning). Since
+      the cost functions do not depend on the PDBs, we compute them up front,
+      which allows to compute the PDBs independently of each other.
+    */
     OperatorsProxy operators = task_proxy.get_operators();
-    remaining_operator_costs.reserve(operators.size());
-    for (OperatorProxy op : operators)
-        remaining_operator_costs.push_back(op.get_cost());
-
-    pattern_databases.reserve(patterns.size());
-    for (const Pattern &pattern : patterns) {
-        shared_ptr<PatternDatabase> pdb =
-            compute_pdb(task_proxy, pattern, remaining_operator_costs);
-
-        /* Set cost of relevant operators to 0 for further iterations
-           (action cost partitioning). */
+    int num_patterns = patterns.size();
+    vector<int> first_relevant_pattern(operators.size(), num_patterns);
+    for (int pattern_id = 0; pattern_id < num_patterns; ++pattern_id) {
         for (OperatorProxy op : operators) {
-            if (is_operator_relevant(pdb->get_pattern(), op))
-                remaining_operator_costs[op.get_id()] = 0;
+            int &first = first_relevant_pattern[op.get_id()];
+            if (first == num_patterns &&
+                is_operator_relevant(patterns[pattern_id], op))
+                first = pattern_id;
         }
-
-        pattern_databases.push_back(pdb);
     }
+
+    pattern_databases = compute_pdbs(
+        task_proxy, patterns, num_threads, [&](int pattern_id) {
+            vector<int> remaining_operator_costs;
+            remaining_operator_costs.reserve(operators.size());
+            for (OperatorProxy op : operators) {
+                if (first_relevant_pattern[op.get_id()] < pattern_id)
+                    remaining_operator_costs.push_back(0);
+                else
+                    remaining_operator_costs.push_back(op.get_cost());
+            }
+            return remaining_operator_costs;
+        });
 }
 
 int ZeroOnePDBs::get_value(const State &state) const {
@@ -56,6 +68,24 @@ int ZeroOnePDBs::get_value(const State &state) const {
     return h_val;
 }
 
+void ZeroOnePDBs::get_values(
+    span<const int> state_values, int num_variables,
+    span<int> values) const {
+    fill(values.begin(), values.end(), 0);
+    vector<int> pdb_values(values.size());
+    for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
+        pdb->get_values(state_values, num_variables, pdb_values);
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i] == numeric_limits<int>::max())
+                continue;
+            if (pdb_values[i] == numeric_limits<int>::max())
+                values[i] = numeric_limits<int>::max();
+            else
+                values[i] += pdb_values[i];
+        }
+    }
+}
+
 double ZeroOnePDBs::compute_approx_mean_finite_h() const {
     double approx_mean_finite_h = 0;
     for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
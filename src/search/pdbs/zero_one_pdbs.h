@@ -3,6 +3,8 @@
 
 #include "types.h"
 
+#include <span>
+
 class State;
 class TaskProxy;
 
@@ -14,10 +16,16 @@ namespace pdbs {
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
 public:
-    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
+    ZeroOnePDBs(
+        const TaskProxy &task_proxy, const PatternCollection &patterns,
+        int num_threads = 1);
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
+    // See PatternDatabase::get_values.
+    void get_values(
+        std::span<const int> state_values, int num_variables,
+        std::span<int> values) const;
     /*
       Returns the sum of all mean finite h-values of every PDB.
       This is an approximation of the real mean finite h-value of the Heuristic,
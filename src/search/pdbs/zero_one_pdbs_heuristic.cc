@@ -9,21 +9,23 @@ using namespace std;
 namespace pdbs {
 static ZeroOnePDBs get_zero_one_pdbs_from_generator(
     const shared_ptr<AbstractTask> &task,
-    const shared_ptr<PatternCollectionGenerator> &pattern_generator) {
+    const shared_ptr<PatternCollectionGenerator> &pattern_generator,
+    int num_threads) {
     PatternCollectionInformation pattern_collection_info =
         pattern_generator->generate(task);
     shared_ptr<PatternCollection> patterns =
         pattern_collection_info.get_patterns();
     TaskProxy task_proxy(*task);
-    return ZeroOnePDBs(task_proxy, *patterns);
+    return ZeroOnePDBs(task_proxy, *patterns, num_threads);
 }
 
 ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
     const shared_ptr<AbstractTask> &task,
-    const shared_ptr<PatternCollectionGenerator> &patterns,
+    const shared_ptr<PatternCollectionGenerator> &patterns, int num_threads,
     bool cache_estimates, const string &description, utils::Verbosity verbosity)
     : Heuristic(task, cache_estimates, description, verbosity),
-      zero_one_pdbs(get_zero_one_pdbs_from_generator(task, patterns)) {
+      zero_one_pdbs(
+          get_zero_one_pdbs_from_generator(task, patterns, num_threads)) {
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const State &ancestor_state) {
@@ -34,6 +36,18 @@ int ZeroOnePDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     return h;
 }
 
+bool ZeroOnePDBsHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    zero_one_pdbs.get_values(
+        convert_ancestor_state_batch(ancestor_states),
+        task_proxy.get_variables().size(), values);
+    for (int &h : values) {
+        if (h == numeric_limits<int>::max())
+            h = DEAD_END;
+    }
+    return true;
+}
+
 class ZeroOnePDBsHeuristicFeature
     : public plugins::TypedFeature<TaskIndependentEvaluator> {
 public:
@@ -53,6 +67,9 @@ public:
 
         add_option<shared_ptr<TaskIndependentPatternCollectionGenerator>>(
             "patterns", "pattern generation method", "systematic(1)");
+        add_option<int>(
+            "threads", "number of threads used to compute the PDBs", "1",
+            plugins::Bounds("1", "infinity"));
         add_heuristic_options_to_feature(*this, "zopdbs");
 
         document_language_support("action costs", "supported");
@@ -71,6 +88,7 @@ public:
             ZeroOnePDBsHeuristic, Evaluator>(
             opts.get<shared_ptr<TaskIndependentPatternCollectionGenerator>>(
                 "patterns"),
+            opts.get<int>("threads"),
             get_heuristic_arguments_from_options(opts));
     }
 };
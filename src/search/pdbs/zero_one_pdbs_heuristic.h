@@ -13,11 +13,14 @@ class ZeroOnePDBsHeuristic : public Heuristic {
     ZeroOnePDBs zero_one_pdbs;
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 public:
     ZeroOnePDBsHeuristic(
         const std::shared_ptr<AbstractTask> &task,
         const std::shared_ptr<PatternCollectionGenerator> &patterns,
-        bool cache_estimates, const std::string &name,
+        int num_threads, bool cache_estimates, const std::string &name,
         utils::Verbosity verbosity);
 };
 }
@@ -142,7 +142,7 @@ public:
         }
         segmented_vector::SegmentedArrayVector<Element> *entries =
             get_entries(registry);
-        int state_id = state.get_id().value;
+        StateID::ValueType state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
         assert(utils::in_bounds(state_id, *registry));
@@ -165,10 +165,10 @@ public:
             ABORT("PerStateArray::operator[] const tried to access "
                   "non-existing entry.");
         }
-        int state_id = state.get_id().value;
+        StateID::ValueType state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         assert(utils::in_bounds(state_id, *registry));
-        int num_entries = entries->size();
+        StateID::ValueType num_entries = entries->size();
         if (state_id >= num_entries) {
             ABORT("PerStateArray::operator[] const tried to access "
                   "non-existing entry.");
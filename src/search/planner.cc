@@ -1,6 +1,7 @@
 #include "command_line.h"
 #include "git_revision.h"
 #include "search_algorithm.h"
+#include "state_values_pool.h"
 
 #include "task_utils/task_properties.h"
 #include "tasks/root_task.h"
@@ -30,12 +31,26 @@ int main(int argc, const char **argv) {
             utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
         }
 
+        TaskInputOptions task_input_options =
+            parse_task_input_options(argc, argv);
+        if (!task_input_options.binary_task_output_filename.empty()) {
+            utils::g_log << get_revision_info() << endl;
+            tasks::convert_root_task_to_binary(
+                cin, task_input_options.binary_task_output_filename);
+            utils::exit_with(ExitCode::SUCCESS);
+        }
+
         shared_ptr<AbstractTask> task;
         bool unit_cost = false;
         if (static_cast<string>(argv[1]) != "--help") {
             utils::g_log << get_revision_info() << endl;
             utils::g_log << "reading input..." << endl;
-            tasks::read_root_task(cin);
+            if (task_input_options.binary_task_filename.empty()) {
+                tasks::read_root_task(cin);
+            } else {
+                tasks::read_binary_root_task(
+                    task_input_options.binary_task_filename);
+            }
             task = tasks::g_root_task;
             /*
               TODO once we get rid of g_root_task, the two lines above should
@@ -69,6 +84,7 @@ int main(int argc, const char **argv) {
 
         search_algorithm->save_plan_if_necessary();
         search_algorithm->print_statistics();
+        state_values_pool::print_statistics(utils::g_log);
         utils::g_log << "Search time: " << search_timer << endl;
         utils::g_log << "Total time: " << utils::g_timer << endl;
 
@@ -0,0 +1,178 @@
+#include "packed_potential_table.h"
+
+#include "potential_function.h"
+
+#include "../task_proxy.h"
+
+#include "../task_utils/task_properties.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace potentials {
+PackedPotentialTable::PackedPotentialTable(
+    const TaskProxy &task_proxy,
+    const vector<const PotentialFunction *> &functions)
+    : task_id(task_proxy.get_id()),
+      num_variables(task_proxy.get_variables().size()),
+      num_functions(functions.size()),
+      sums(functions.size()) {
+    assert(num_functions > 0);
+    assert(can_represent(task_proxy, functions));
+    const int_packer::IntPacker &state_packer =
+        task_properties::g_state_packers[task_proxy];
+    int num_facts = 0;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        int var_id = var.get_id();
+        bin_indices.push_back(state_packer.get_bin_index(var_id));
+        shifts.push_back(state_packer.get_shift(var_id));
+        read_masks.push_back(state_packer.get_read_mask(var_id));
+        fact_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+    }
+
+    const double scale = static_cast<double>(int64_t(1) << FRACTION_BITS);
+    weights.resize(num_facts * num_functions);
+    for (int function_id = 0; function_id < num_functions; ++function_id) {
+        const vector<vector<double>> &fact_potentials =
+            functions[function_id]->get_fact_potentials();
+        for (int var = 0; var < num_variables; ++var) {
+            for (size_t value = 0; value < fact_potentials[var].size();
+                 ++value) {
+                int fact_index = fact_offsets[var] + value;
+                weights[fact_index * num_functions + function_id] =
+                    static_cast<int64_t>(
+                        floor(fact_potentials[var][value] * scale));
+            }
+        }
+    }
+}
+
+bool PackedPotentialTable::can_represent(
+    const TaskProxy &task_proxy,
+    const vector<const PotentialFunction *> &functions) {
+    /*
+      Bound the absolute value of all partial sums of fixed-point
+      potentials, leaving some room for the rounding and the tolerance.
+    */
+    const double max_sum =
+        ldexp(1.0, numeric_limits<int64_t>::digits - FRACTION_BITS - 1);
+    int num_variables = task_proxy.get_variables().size();
+    for (const PotentialFunction *function : functions) {
+        const vector<vector<double>> &fact_potentials =
+            function->get_fact_potentials();
+        double sum = 0.0;
+        for (int var = 0; var < num_variables; ++var) {
+            double max_potential = 0.0;
+            for (double potential : fact_potentials[var]) {
+                if (!isfinite(potential))
+                    return false;
+                max_potential = max(max_potential, abs(potential));
+            }
+            sum += max_potential + 1.0;
+        }
+        if (sum >= max_sum)
+            return false;
+    }
+    return true;
+}
+
+bool PackedPotentialTable::can_evaluate(const State &state) const {
+    return state.get_registry() && state.get_task().get_id() == task_id;
+}
+
+int PackedPotentialTable::get_fact_index(const Bin *buffer, int var) const {
+    int value = (buffer[bin_indices[var]] & read_masks[var]) >> shifts[var];
+    return fact_offsets[var] + value;
+}
+
+int64_t PackedPotentialTable::compute_sum(const Bin *buffer) const {
+    assert(num_functions == 1);
+    int64_t sum = 0;
+    int var = 0;
+#ifdef __AVX2__
+    static_assert(sizeof(Bin) == sizeof(int));
+    const int *bins = reinterpret_cast<const int *>(buffer);
+    const long long *weight_table =
+        reinterpret_cast<const long long *>(weights.data());
+    __m256i sums_low = _mm256_setzero_si256();
+    __m256i sums_high = _mm256_setzero_si256();
+    for (; var + 8 <= num_variables; var += 8) {
+        __m256i packed_bins = _mm256_i32gather_epi32(
+            bins,
+            _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(&bin_indices[var])),
+            sizeof(Bin));
+        __m256i values = _mm256_srlv_epi32(
+            _mm256_and_si256(
+                packed_bins,
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i *>(&read_masks[var]))),
+            _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(&shifts[var])));
+        __m256i fact_indices = _mm256_add_epi32(
+            values, _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(&fact_offsets[var])));
+        sums_low = _mm256_add_epi64(
+            sums_low, _mm256_i32gather_epi64(
+                          weight_table, _mm256_castsi256_si128(fact_indices),
+                          sizeof(int64_t)));
+        sums_high = _mm256_add_epi64(
+            sums_high,
+            _mm256_i32gather_epi64(
+                weight_table, _mm256_extracti128_si256(fact_indices, 1),
+                sizeof(int64_t)));
+    }
+    alignas(32) int64_t partial_sums[4];
+    _mm256_store_si256(
+        reinterpret_cast<__m256i *>(partial_sums),
+        _mm256_add_epi64(sums_low, sums_high));
+    sum = partial_sums[0] + partial_sums[1] + partial_sums[2] + partial_sums[3];
+#endif
+    for (; var < num_variables; ++var) {
+        sum += weights[get_fact_index(buffer, var)];
+    }
+    return sum;
+}
+
+int PackedPotentialTable::convert_sum_to_value(int64_t sum) {
+    /*
+      Compute ceil((sum - TOLERANCE) / 2^FRACTION_BITS). Right shifts of
+      negative numbers round towards negative infinity.
+    */
+    int64_t shifted_sum = sum - TOLERANCE;
+    return static_cast<int>(-((-shifted_sum) >> FRACTION_BITS));
+}
+
+int PackedPotentialTable::get_value(const State &state) const {
+    assert(can_evaluate(state));
+    return convert_sum_to_value(compute_sum(state.get_buffer()));
+}
+
+int PackedPotentialTable::get_max_value(const State &state) {
+    assert(can_evaluate(state));
+    const Bin *buffer = state.get_buffer();
+    fill(sums.begin(), sums.end(), 0);
+    for (int var = 0; var < num_variables; ++var) {
+        /*
+          The potentials of a fact under all functions are contiguous, so
+          the compiler can vectorize this loop over the functions.
+        */
+        const int64_t *fact_weights =
+            &weights[get_fact_index(buffer, var) * num_functions];
+        for (int function_id = 0; function_id < num_functions;
+             ++function_id) {
+            sums[function_id] += fact_weights[function_id];
+        }
+    }
+    return convert_sum_to_value(*max_element(sums.begin(), sums.end()));
+}
+}
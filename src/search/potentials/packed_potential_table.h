@@ -0,0 +1,96 @@
+#ifndef POTENTIALS_PACKED_POTENTIAL_TABLE_H
+#define POTENTIALS_PACKED_POTENTIAL_TABLE_H
+
+#include "../task_id.h"
+
+#include "../algorithms/int_packer.h"
+
+#include <cstdint>
+#include <vector>
+
+class State;
+class TaskProxy;
+
+namespace potentials {
+class PotentialFunction;
+
+/*
+  Evaluate one or more potential functions directly on packed states.
+
+  The potentials of all facts are stored in one flat table of fixed-point
+  numbers. The table is indexed with the bins of a packed state, so
+  evaluating a state requires neither unpacking it nor converting
+  floating-point numbers. If the planner is compiled for a machine that
+  supports AVX2 (see the CMake option USE_NATIVE_ARCH), we extract the
+  values of eight variables at a time and look up their potentials with
+  SIMD gather instructions.
+
+  With several potential functions, the potentials of a fact under all
+  functions are stored next to each other, so that we can add them for all
+  functions at once and maximize over the sums.
+
+  Each potential is rounded down to a multiple of 2^-FRACTION_BITS. The
+  result is therefore never larger than the value computed by
+  PotentialFunction::get_value(). It can only be smaller if the exact sum
+  of potentials lies within num_variables * 2^-FRACTION_BITS of the rounding
+  threshold.
+*/
+class PackedPotentialTable {
+    using Bin = int_packer::IntPacker::Bin;
+
+    static const int FRACTION_BITS = 20;
+    /*
+      PotentialFunction::get_value() subtracts 0.01 before rounding up to
+      account for imprecise LP solutions. We use the next larger
+      fixed-point number, which can only decrease the result.
+    */
+    static const std::int64_t TOLERANCE =
+        (std::int64_t(1) << FRACTION_BITS) / 100 + 1;
+
+    TaskID task_id;
+    int num_variables;
+    int num_functions;
+
+    // Storage location of each variable in the packed states.
+    std::vector<int> bin_indices;
+    std::vector<int> shifts;
+    std::vector<Bin> read_masks;
+    // Index of the first fact of each variable in the weights table.
+    std::vector<int> fact_offsets;
+    // weights[fact_index * num_functions + function_index]
+    std::vector<std::int64_t> weights;
+
+    // Reused by get_max_value() to avoid allocations.
+    std::vector<std::int64_t> sums;
+
+    int get_fact_index(const Bin *buffer, int var) const;
+    std::int64_t compute_sum(const Bin *buffer) const;
+    static int convert_sum_to_value(std::int64_t sum);
+
+public:
+    PackedPotentialTable(
+        const TaskProxy &task_proxy,
+        const std::vector<const PotentialFunction *> &functions);
+
+    /*
+      Return true if the potentials of the given functions can be summed
+      in fixed-point arithmetic without overflows.
+    */
+    static bool can_represent(
+        const TaskProxy &task_proxy,
+        const std::vector<const PotentialFunction *> &functions);
+
+    /*
+      Return true if the given state is registered and belongs to the task
+      of this table, so that we can evaluate its packed values.
+    */
+    bool can_evaluate(const State &state) const;
+
+    // Requires that the table was built for exactly one function.
+    int get_value(const State &state) const;
+    // Return the maximum value over all functions.
+    int get_max_value(const State &state);
+};
+}
+
+#endif
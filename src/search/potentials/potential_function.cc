@@ -26,4 +26,16 @@ int PotentialFunction::get_value(const State &state) const {
     const double epsilon = 0.01;
     return static_cast<int>(ceil(heuristic_value - epsilon));
 }
+
+int PotentialFunction::get_value(span<const int> state_values) const {
+    assert(state_values.size() == fact_potentials.size());
+    double heuristic_value = 0.0;
+    for (size_t var_id = 0; var_id < state_values.size(); ++var_id) {
+        int value = state_values[var_id];
+        assert(utils::in_bounds(value, fact_potentials[var_id]));
+        heuristic_value += fact_potentials[var_id][value];
+    }
+    const double epsilon = 0.01;
+    return static_cast<int>(ceil(heuristic_value - epsilon));
+}
 }
@@ -1,6 +1,7 @@
 #ifndef POTENTIALS_POTENTIAL_FUNCTION_H
 #define POTENTIALS_POTENTIAL_FUNCTION_H
 
+#include <span>
 #include <vector>
 
 class State;
@@ -21,6 +22,11 @@ public:
     ~PotentialFunction() = default;
 
     int get_value(const State &state) const;
+    int get_value(std::span<const int> state_values) const;
+
+    const std::vector<std::vector<double>> &get_fact_potentials() const {
+        return fact_potentials;
+    }
 };
 }
 
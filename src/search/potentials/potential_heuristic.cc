@@ -1,9 +1,12 @@
 #include "potential_heuristic.h"
 
+#include "packed_potential_table.h"
 #include "potential_function.h"
 
 #include "../plugins/plugin.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace potentials {
@@ -13,10 +16,45 @@ PotentialHeuristic::PotentialHeuristic(
     const string &description, utils::Verbosity verbosity)
     : Heuristic(task, cache_estimates, description, verbosity),
       function(move(function)) {
+    vector<const PotentialFunction *> functions = {this->function.get()};
+    if (PackedPotentialTable::can_represent(task_proxy, functions)) {
+        packed_table =
+            make_unique<PackedPotentialTable>(task_proxy, functions);
+    }
+}
+
+PotentialHeuristic::~PotentialHeuristic() {
 }
 
 int PotentialHeuristic::compute_heuristic(const State &ancestor_state) {
+    if (packed_table && packed_table->can_evaluate(ancestor_state)) {
+        return max(0, packed_table->get_value(ancestor_state));
+    }
     State state = convert_ancestor_state(ancestor_state);
     return max(0, function->get_value(state));
 }
+
+bool PotentialHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    if (packed_table &&
+        all_of(
+            ancestor_states.begin(), ancestor_states.end(),
+            [this](const State &state) {
+                return packed_table->can_evaluate(state);
+            })) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = max(0, packed_table->get_value(ancestor_states[i]));
+        }
+        return true;
+    }
+    span<const int> state_values =
+        convert_ancestor_state_batch(ancestor_states);
+    int num_variables = task_proxy.get_variables().size();
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = max(
+            0, function->get_value(
+                   state_values.subspan(i * num_variables, num_variables)));
+    }
+    return true;
+}
 }
@@ -6,6 +6,7 @@
 #include <memory>
 
 namespace potentials {
+class PackedPotentialTable;
 class PotentialFunction;
 
 /*
@@ -13,15 +14,21 @@ class PotentialFunction;
 */
 class PotentialHeuristic : public Heuristic {
     std::unique_ptr<PotentialFunction> function;
+    // Used for registered states of our task if it can represent function.
+    std::unique_ptr<PackedPotentialTable> packed_table;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 
 public:
     PotentialHeuristic(
         const std::shared_ptr<AbstractTask> &task,
         std::unique_ptr<PotentialFunction> function, bool cache_estimates,
         const std::string &description, utils::Verbosity verbosity);
+    virtual ~PotentialHeuristic() override;
 };
 }
 
@@ -1,9 +1,12 @@
 #include "potential_max_heuristic.h"
 
+#include "packed_potential_table.h"
 #include "potential_function.h"
 
 #include "../plugins/plugin.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace potentials {
@@ -13,9 +16,24 @@ PotentialMaxHeuristic::PotentialMaxHeuristic(
     const string &description, utils::Verbosity verbosity)
     : Heuristic(task, cache_estimates, description, verbosity),
       functions(move(functions)) {
+    vector<const PotentialFunction *> function_ptrs;
+    for (const unique_ptr<PotentialFunction> &function : this->functions) {
+        function_ptrs.push_back(function.get());
+    }
+    if (!function_ptrs.empty() &&
+        PackedPotentialTable::can_represent(task_proxy, function_ptrs)) {
+        packed_table =
+            make_unique<PackedPotentialTable>(task_proxy, function_ptrs);
+    }
+}
+
+PotentialMaxHeuristic::~PotentialMaxHeuristic() {
 }
 
 int PotentialMaxHeuristic::compute_heuristic(const State &ancestor_state) {
+    if (packed_table && packed_table->can_evaluate(ancestor_state)) {
+        return max(0, packed_table->get_max_value(ancestor_state));
+    }
     State state = convert_ancestor_state(ancestor_state);
     int value = 0;
     for (auto &function : functions) {
@@ -23,4 +41,33 @@ int PotentialMaxHeuristic::compute_heuristic(const State &ancestor_state) {
     }
     return value;
 }
+
+bool PotentialMaxHeuristic::compute_heuristic_batch(
+    span<const State> ancestor_states, span<int> values) {
+    if (packed_table &&
+        all_of(
+            ancestor_states.begin(), ancestor_states.end(),
+            [this](const State &state) {
+                return packed_table->can_evaluate(state);
+            })) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] =
+                max(0, packed_table->get_max_value(ancestor_states[i]));
+        }
+        return true;
+    }
+    span<const int> state_values =
+        convert_ancestor_state_batch(ancestor_states);
+    int num_variables = task_proxy.get_variables().size();
+    fill(values.begin(), values.end(), 0);
+    for (auto &function : functions) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = max(
+                values[i],
+                function->get_value(
+                    state_values.subspan(i * num_variables, num_variables)));
+        }
+    }
+    return true;
+}
 }
@@ -7,6 +7,7 @@
 #include <vector>
 
 namespace potentials {
+class PackedPotentialTable;
 class PotentialFunction;
 
 /*
@@ -14,9 +15,14 @@ class PotentialFunction;
 */
 class PotentialMaxHeuristic : public Heuristic {
     std::vector<std::unique_ptr<PotentialFunction>> functions;
+    // Used for registered states of our task if it can represent functions.
+    std::unique_ptr<PackedPotentialTable> packed_table;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual bool compute_heuristic_batch(
+        std::span<const State> ancestor_states,
+        std::span<int> values) override;
 
 public:
     PotentialMaxHeuristic(
@@ -24,6 +30,7 @@ public:
         std::vector<std::unique_ptr<PotentialFunction>> &&functions,
         bool cache_estimates, const std::string &description,
         utils::Verbosity verbosity);
+    virtual ~PotentialMaxHeuristic() override;
 };
 }
 
@@ -2,6 +2,7 @@
 
 #include "evaluation_context.h"
 #include "evaluator.h"
+#include "shared_incumbent.h"
 
 #include "algorithms/ordered_set.h"
 #include "plugins/plugin.h"
@@ -12,6 +13,7 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -19,12 +21,13 @@ using namespace std;
 using utils::ExitCode;
 
 static successor_generator::SuccessorGenerator &get_successor_generator(
-    const TaskProxy &task_proxy, utils::LogProxy &log) {
+    const TaskProxy &task_proxy,
+    successor_generator::SuccessorGeneratorType type, utils::LogProxy &log) {
     log << "Building successor generator... " << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator &successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        successor_generator::get_successor_generator(task_proxy, type);
     successor_generator_timer.stop();
     log << "done!" << endl;
     int peak_memory_after = utils::get_peak_memory_in_kb();
@@ -38,20 +41,25 @@ static successor_generator::SuccessorGenerator &get_successor_generator(
 
 SearchAlgorithm::SearchAlgorithm(
     const shared_ptr<AbstractTask> &task, OperatorCost cost_type, int bound,
-    double max_time, const string &description, utils::Verbosity verbosity)
+    double max_time, const string &description, utils::Verbosity verbosity,
+    bool store_parents,
+    successor_generator::SuccessorGeneratorType successor_generator_type)
     : components::TaskSpecificComponent(task),
       description(description),
       status(IN_PROGRESS),
       solution_found(false),
       log(utils::get_log_for_verbosity(verbosity)),
       state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy, log)),
-      search_space(state_registry, log),
+      successor_generator(get_successor_generator(
+          task_proxy, successor_generator_type, log)),
+      search_space(state_registry, cost_type, store_parents, log),
       statistics(log),
       bound(bound),
       cost_type(cost_type),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
-      max_time(max_time) {
+      max_time(max_time),
+      stop_flag(nullptr),
+      shared_incumbent(nullptr) {
     if (bound < 0) {
         cerr << "error: negative cost bound " << bound << endl;
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -75,6 +83,16 @@ const Plan &SearchAlgorithm::get_plan() const {
 void SearchAlgorithm::set_plan(const Plan &p) {
     solution_found = true;
     plan = p;
+    if (shared_incumbent) {
+        shared_incumbent->report_plan(plan, task_proxy);
+    }
+}
+
+void SearchAlgorithm::set_concurrent_search_controls(
+    const atomic<bool> *stop_flag_, SharedIncumbent *shared_incumbent_) {
+    assert(stop_flag_ && shared_incumbent_);
+    stop_flag = stop_flag_;
+    shared_incumbent = shared_incumbent_;
 }
 
 void SearchAlgorithm::search() {
@@ -87,6 +105,15 @@ void SearchAlgorithm::search() {
             status = TIMEOUT;
             break;
         }
+        if (shared_incumbent) {
+            if (status == IN_PROGRESS &&
+                stop_flag->load(memory_order_relaxed)) {
+                log << "Search stopped." << endl;
+                status = TIMEOUT;
+                break;
+            }
+            bound = min(bound, shared_incumbent->get_cost());
+        }
     }
     // TODO: Revise when and which search times are logged.
     log << "Actual search time: " << timer.get_elapsed_time() << endl;
@@ -143,6 +170,26 @@ get_search_pruning_arguments_from_options(const plugins::Options &opts) {
         opts.get<shared_ptr<TaskIndependentPruningMethod>>("pruning"));
 }
 
+void add_bound_evaluator_option_to_feature(plugins::Feature &feature) {
+    feature.add_option<shared_ptr<TaskIndependentEvaluator>>(
+        "bound_evaluator",
+        "admissible evaluator used together with the bound to prune states: "
+        "a reached state is discarded if its real g value plus its estimate "
+        "is at least the bound. The estimate has to be admissible with "
+        "respect to the real operator costs. Cheap evaluators such as hmax "
+        "or a PDB work best. This is mostly useful in anytime searches, "
+        "where the bound is the cost of the best plan found so far. The "
+        "number of pruned states is reported in the statistics.",
+        plugins::ArgumentInfo::NO_DEFAULT);
+}
+
+tuple<shared_ptr<TaskIndependentEvaluator>>
+get_bound_evaluator_arguments_from_options(const plugins::Options &opts) {
+    return make_tuple(
+        opts.get<shared_ptr<TaskIndependentEvaluator>>(
+            "bound_evaluator", nullptr));
+}
+
 void add_search_algorithm_options_to_feature(
     plugins::Feature &feature, const string &description) {
     ::add_cost_type_options_to_feature(feature);
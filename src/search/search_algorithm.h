@@ -2,6 +2,7 @@
 #define SEARCH_ALGORITHM_H
 
 #include "component.h"
+#include "evaluator.h"
 #include "operator_cost.h"
 #include "operator_id.h"
 #include "plan_manager.h"
@@ -12,8 +13,10 @@
 #include "state_registry.h"
 #include "task_proxy.h"
 
+#include "task_utils/successor_generator.h"
 #include "utils/logging.h"
 
+#include <atomic>
 #include <vector>
 
 namespace plugins {
@@ -21,15 +24,13 @@ class Options;
 class Feature;
 }
 
+class SharedIncumbent;
+
 namespace ordered_set {
 template<typename T>
 class OrderedSet;
 }
 
-namespace successor_generator {
-class SuccessorGenerator;
-}
-
 enum SearchStatus {
     IN_PROGRESS,
     TIMEOUT,
@@ -54,6 +55,9 @@ protected:
     OperatorCost cost_type;
     bool is_unit_cost;
     double max_time;
+    // Both are null unless the search runs concurrently with other searches.
+    const std::atomic<bool> *stop_flag;
+    SharedIncumbent *shared_incumbent;
 
     virtual void initialize() {
     }
@@ -66,7 +70,9 @@ public:
     SearchAlgorithm(
         const std::shared_ptr<AbstractTask> &task, OperatorCost cost_type,
         int bound, double max_time, const std::string &description,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity, bool store_parents = true,
+        successor_generator::SuccessorGeneratorType successor_generator_type =
+            successor_generator::SuccessorGeneratorType::TREE);
     virtual void print_statistics() const = 0;
     virtual void save_plan_if_necessary();
     bool found_solution() const;
@@ -82,6 +88,15 @@ public:
     int get_bound() {
         return bound;
     }
+    /*
+      Connect the search to other searches that run concurrently in other
+      threads. The search reports all plans it finds to the shared incumbent
+      and lowers its bound to the cost of the incumbent after every step. It
+      stops after the current step once *stop_flag is set, which counts as a
+      timeout.
+    */
+    void set_concurrent_search_controls(
+        const std::atomic<bool> *stop_flag, SharedIncumbent *shared_incumbent);
     PlanManager &get_plan_manager() {
         return plan_manager;
     }
@@ -106,6 +121,9 @@ extern void collect_preferred_operators(
 extern void add_search_pruning_options_to_feature(plugins::Feature &feature);
 extern std::tuple<std::shared_ptr<TaskIndependentPruningMethod>>
 get_search_pruning_arguments_from_options(const plugins::Options &opts);
+extern void add_bound_evaluator_option_to_feature(plugins::Feature &feature);
+extern std::tuple<std::shared_ptr<TaskIndependentEvaluator>>
+get_bound_evaluator_arguments_from_options(const plugins::Options &opts);
 extern void add_search_algorithm_options_to_feature(
     plugins::Feature &feature, const std::string &description);
 extern std::tuple<OperatorCost, int, double, std::string, utils::Verbosity>
@@ -10,6 +10,7 @@
 #include "../task_utils/successor_generator.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -25,20 +26,39 @@ EagerSearch::EagerSearch(
     const shared_ptr<Evaluator> &f_eval,
     const vector<shared_ptr<Evaluator>> &preferred,
     const shared_ptr<PruningMethod> &pruning,
-    const shared_ptr<Evaluator> &lazy_evaluator, OperatorCost cost_type,
-    int bound, double max_time, const string &description,
-    utils::Verbosity verbosity)
-    : SearchAlgorithm(task, cost_type, bound, max_time, description, verbosity),
+    const shared_ptr<Evaluator> &lazy_evaluator,
+    const shared_ptr<Evaluator> &bound_evaluator,
+    const shared_ptr<parallel_evaluator::ParallelEvaluator> &parallel_evaluator,
+    bool batch_evaluation, bool store_parents,
+    successor_generator::SuccessorGeneratorType successor_generator_type,
+    OperatorCost cost_type, int bound, double max_time,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          task, cost_type, bound, max_time, description, verbosity,
+          store_parents, successor_generator_type),
       reopen_closed_nodes(reopen_closed),
       open_list(open->create_state_open_list()),
       f_evaluator(f_eval), // default nullptr
       preferred_operator_evaluators(preferred),
       lazy_evaluator(lazy_evaluator), // default nullptr
-      pruning_method(pruning) {
+      bound_evaluator(bound_evaluator), // default nullptr
+      pruning_method(pruning),
+      parallel_evaluator(parallel_evaluator), // default nullptr
+      batch_evaluation(batch_evaluation) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
+    if (lazy_evaluator && parallel_evaluator) {
+        cerr << "lazy_evaluator is not supported with more than one thread"
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+    if (batch_evaluation && parallel_evaluator) {
+        cerr << "batch_evaluation is not supported with more than one thread"
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
 }
 
 void EagerSearch::initialize() {
@@ -76,6 +96,10 @@ void EagerSearch::initialize() {
         lazy_evaluator->get_path_dependent_evaluators(evals);
     }
 
+    if (bound_evaluator) {
+        bound_evaluator->get_path_dependent_evaluators(evals);
+    }
+
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
     State initial_state = state_registry.get_initial_state();
@@ -83,6 +107,22 @@ void EagerSearch::initialize() {
         evaluator->notify_initial_state(initial_state);
     }
 
+    if (parallel_evaluator) {
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "path-dependent evaluators are not supported with more "
+                 << "than one thread" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+        log << "Evaluating successors with "
+            << parallel_evaluator->get_num_threads() << " threads" << endl;
+        parallel_evaluator->initialize(initial_state);
+    }
+    if (batch_evaluation && !path_dependent_evaluators.empty()) {
+        cerr << "path-dependent evaluators are not supported with batch "
+             << "evaluation" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
     /*
       Note: we consider the initial state as reached by a preferred
       operator.
@@ -110,8 +150,31 @@ void EagerSearch::initialize() {
 
 void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
+    if (bound_evaluator) {
+        log << "Pruned by bound: " << statistics.get_pruned_by_bound()
+            << " state(s)." << endl;
+    }
     search_space.print_statistics();
     pruning_method->print_statistics();
+
+    vector<Evaluator *> evals;
+    open_list->get_evaluators(evals);
+    for (const shared_ptr<Evaluator> &evaluator :
+         preferred_operator_evaluators) {
+        evaluator->get_evaluators(evals);
+    }
+    if (f_evaluator) {
+        f_evaluator->get_evaluators(evals);
+    }
+    if (lazy_evaluator) {
+        lazy_evaluator->get_evaluators(evals);
+    }
+    if (bound_evaluator) {
+        bound_evaluator->get_evaluators(evals);
+    }
+    for (Evaluator *evaluator : evals) {
+        evaluator->print_statistics();
+    }
 }
 
 SearchStatus EagerSearch::step() {
@@ -207,6 +270,49 @@ SearchStatus EagerSearch::expand(const SearchNode &node) {
     return IN_PROGRESS;
 }
 
+/*
+  Evaluate all successors that are new before the expansion in parallel or
+  as one batch. We only compute what the serial loop in generate_successors
+  would compute for a new node, using the same g value and preferredness, so
+  the search behaves exactly like a search that evaluates one successor at a
+  time. If the same new state is reached several times from this node, we
+  only evaluate its first occurrence because the node is usually no longer
+  new when the serial loop reaches the others. If it is still new (because
+  the bound evaluator pruned the first occurrence), generate_successors
+  evaluates the later occurrence on its own.
+*/
+void EagerSearch::evaluate_new_successors(
+    const SearchNode &node, const vector<pair<OperatorID, State>> &successors,
+    const ordered_set::OrderedSet<OperatorID> &preferred_operators,
+    vector<optional<EvaluationContext>> &successor_contexts) {
+    successor_contexts.resize(successors.size());
+    vector<EvaluationContext *> new_contexts;
+    for (size_t i = 0; i < successors.size(); ++i) {
+        OperatorID op_id = successors[i].first;
+        const State &succ_state = successors[i].second;
+        auto same_state = [&](const pair<OperatorID, State> &successor) {
+            return successor.second.get_id() == succ_state.get_id();
+        };
+        if (search_space.get_node(succ_state).is_new() &&
+            none_of(successors.begin(), successors.begin() + i, same_state)) {
+            OperatorProxy op = task_proxy.get_operators()[op_id];
+            int succ_g = node.get_g() + get_adjusted_cost(op);
+            bool is_preferred = preferred_operators.contains(op_id);
+            successor_contexts[i].emplace(
+                succ_state, succ_g, is_preferred, &statistics);
+            new_contexts.push_back(&*successor_contexts[i]);
+        }
+    }
+    if (parallel_evaluator) {
+        parallel_evaluator->evaluate(*open_list, new_contexts);
+    } else {
+        assert(batch_evaluation);
+        open_list->compute_batch_results(new_contexts);
+        if (bound_evaluator)
+            bound_evaluator->compute_batch_results(new_contexts);
+    }
+}
+
 void EagerSearch::generate_successors(const SearchNode &node) {
     const State &state = node.get_state();
 
@@ -223,6 +329,8 @@ void EagerSearch::generate_successors(const SearchNode &node) {
     ordered_set::OrderedSet<OperatorID> preferred_operators;
     collect_preferred_operators_for_node(node, preferred_operators);
 
+    vector<pair<OperatorID, State>> successors;
+    successors.reserve(applicable_operators.size());
     for (OperatorID op_id : applicable_operators) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         if ((node.get_real_g() + op.get_cost()) >= bound)
@@ -230,7 +338,20 @@ void EagerSearch::generate_successors(const SearchNode &node) {
 
         State succ_state = state_registry.get_successor_state(state, op);
         statistics.inc_generated();
+        successors.emplace_back(op_id, move(succ_state));
+    }
 
+    vector<optional<EvaluationContext>> successor_contexts;
+    bool evaluate_in_advance = parallel_evaluator || batch_evaluation;
+    if (evaluate_in_advance) {
+        evaluate_new_successors(
+            node, successors, preferred_operators, successor_contexts);
+    }
+
+    for (size_t i = 0; i < successors.size(); ++i) {
+        OperatorID op_id = successors[i].first;
+        const State &succ_state = successors[i].second;
+        OperatorProxy op = task_proxy.get_operators()[op_id];
         SearchNode succ_node = search_space.get_node(succ_state);
 
         for (Evaluator *evaluator : path_dependent_evaluators) {
@@ -253,10 +374,28 @@ void EagerSearch::generate_successors(const SearchNode &node) {
             */
             int succ_g = node.get_g() + get_adjusted_cost(op);
 
-            EvaluationContext succ_eval_context(
-                succ_state, succ_g, is_preferred, &statistics);
+            /*
+              With parallel or batch evaluation, the context of the first
+              occurrence of each new successor has already been evaluated.
+              Later occurrences of a state are only new here if the bound
+              evaluator pruned the earlier ones.
+            */
+            EvaluationContext succ_eval_context =
+                evaluate_in_advance && successor_contexts[i]
+                    ? move(*successor_contexts[i])
+                    : EvaluationContext(
+                          succ_state, succ_g, is_preferred, &statistics);
             statistics.inc_evaluated_states();
 
+            /*
+              A pruned node stays new, so its state is evaluated again
+              whenever it is reached.
+            */
+            if (prune_by_bound(
+                    succ_eval_context, node.get_real_g() + op.get_cost())) {
+                continue;
+            }
+
             if (open_list->is_dead_end(succ_eval_context)) {
                 succ_node.mark_as_dead_end();
                 statistics.inc_dead_ends();
@@ -309,6 +448,18 @@ void EagerSearch::generate_successors(const SearchNode &node) {
     }
 }
 
+bool EagerSearch::prune_by_bound(EvaluationContext &eval_context, int real_g) {
+    if (!bound_evaluator) {
+        return false;
+    }
+    int h = eval_context.get_evaluator_value_or_infinity(bound_evaluator.get());
+    if (h == EvaluationResult::INFTY || real_g + h >= bound) {
+        statistics.inc_pruned_by_bound();
+        return true;
+    }
+    return false;
+}
+
 void EagerSearch::reward_progress() {
     // Boost the "preferred operator" open lists somewhat whenever
     // one of the heuristics finds a state with a new best h value.
@@ -339,20 +490,77 @@ void EagerSearch::update_f_value_statistics(EvaluationContext &eval_context) {
 void add_eager_search_options_to_feature(
     plugins::Feature &feature, const string &description) {
     add_search_pruning_options_to_feature(feature);
+    add_bound_evaluator_option_to_feature(feature);
     // We do not add a lazy_evaluator options here
     // because it is only used for astar but not the other plugins.
+    feature.add_option<int>(
+        "threads",
+        "number of threads used to evaluate the successors of an expanded "
+        "state",
+        "1", plugins::Bounds("1", "infinity"));
+    feature.add_option<bool>(
+        "batch_evaluation",
+        "evaluate all new successors of an expanded state with one call to "
+        "each evaluator of the open list, which lets evaluators with a batch "
+        "implementation amortize their work over the successors",
+        "false");
+    feature.add_option<bool>(
+        "store_parents",
+        "store the parent state and the creating operator of each search "
+        "node. Without them, the plan is reconstructed by regression from the "
+        "goal state when a solution is found, which saves memory per state "
+        "but takes longer",
+        "true");
+    feature.add_option<successor_generator::SuccessorGeneratorType>(
+        "successor_generator",
+        "representation of the successor generator used to compute the "
+        "applicable operators of a state",
+        "tree");
     add_search_algorithm_options_to_feature(feature, description);
+
+    feature.document_note(
+        "Parallel successor evaluation",
+        "With threads=n for n > 1, all new successors of an expanded state are "
+        "evaluated as a batch by n threads before they are inserted into the "
+        "open list in the usual order, so the search expands the same states "
+        "as with a single thread. Each additional thread uses its own copy of "
+        "the evaluators of the open list (which increases memory usage and "
+        "preprocessing time accordingly). Path-dependent evaluators (e.g. "
+        "landmark heuristics) and lazy evaluators are not supported. Note that "
+        "max_time and the reported times measure the CPU time of all threads.");
+    feature.document_note(
+        "Memory per search node",
+        "Search nodes only store real g values if cost_type adjusts operator "
+        "costs. With store_parents=false, they also do not store parent "
+        "pointers. The reconstructed plan then only visits reached states and "
+        "its cost is at most the g value of the goal state, so optimal "
+        "searches still find optimal plans. The memory used per search node "
+        "is reported in the statistics.");
 }
 
 tuple<
     shared_ptr<TaskIndependentPruningMethod>,
-    shared_ptr<TaskIndependentEvaluator>, OperatorCost, int, double, string,
-    utils::Verbosity>
-get_eager_search_arguments_from_options(const plugins::Options &opts) {
+    shared_ptr<TaskIndependentEvaluator>,
+    shared_ptr<TaskIndependentEvaluator>,
+    shared_ptr<parallel_evaluator::TaskIndependentParallelEvaluator>,
+    bool, bool, successor_generator::SuccessorGeneratorType, OperatorCost,
+    int, double, string, utils::Verbosity>
+get_eager_search_arguments_from_options(
+    const plugins::Options &opts,
+    const shared_ptr<TaskIndependentOpenListFactory> &open) {
     return tuple_cat(
         get_search_pruning_arguments_from_options(opts),
-        make_tuple(opts.get<shared_ptr<TaskIndependentEvaluator>>(
-            "lazy_evaluator", nullptr)),
+        make_tuple(
+            opts.get<shared_ptr<TaskIndependentEvaluator>>(
+                "lazy_evaluator", nullptr)),
+        get_bound_evaluator_arguments_from_options(opts),
+        make_tuple(
+            parallel_evaluator::create_parallel_evaluator(
+                open, opts.get<int>("threads")),
+            opts.get<bool>("batch_evaluation"),
+            opts.get<bool>("store_parents"),
+            opts.get<successor_generator::SuccessorGeneratorType>(
+                "successor_generator")),
         get_search_algorithm_arguments_from_options(opts));
 }
 }
@@ -1,12 +1,16 @@
 #ifndef SEARCH_ALGORITHMS_EAGER_SEARCH_H
 #define SEARCH_ALGORITHMS_EAGER_SEARCH_H
 
+#include "parallel_evaluator.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
+#include "../open_list_factory.h"
 #include "../search_algorithm.h"
 
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 class Evaluator;
@@ -27,18 +31,27 @@ class EagerSearch : public SearchAlgorithm {
     std::vector<Evaluator *> path_dependent_evaluators;
     std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
     std::shared_ptr<Evaluator> lazy_evaluator;
+    std::shared_ptr<Evaluator> bound_evaluator;
 
     std::shared_ptr<PruningMethod> pruning_method;
+    std::shared_ptr<parallel_evaluator::ParallelEvaluator> parallel_evaluator;
+    const bool batch_evaluation;
 
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
+    bool prune_by_bound(EvaluationContext &eval_context, int real_g);
 
     std::optional<SearchNode> get_next_node_to_expand();
     void collect_preferred_operators_for_node(
         const SearchNode &node,
         ordered_set::OrderedSet<OperatorID> &preferred_operators);
     SearchStatus expand(const SearchNode &node);
+    void evaluate_new_successors(
+        const SearchNode &node,
+        const std::vector<std::pair<OperatorID, State>> &successors,
+        const ordered_set::OrderedSet<OperatorID> &preferred_operators,
+        std::vector<std::optional<EvaluationContext>> &successor_contexts);
     void generate_successors(const SearchNode &node);
 
 protected:
@@ -53,6 +66,11 @@ public:
         const std::vector<std::shared_ptr<Evaluator>> &preferred,
         const std::shared_ptr<PruningMethod> &pruning,
         const std::shared_ptr<Evaluator> &lazy_evaluator,
+        const std::shared_ptr<Evaluator> &bound_evaluator,
+        const std::shared_ptr<parallel_evaluator::ParallelEvaluator>
+            &parallel_evaluator,
+        bool batch_evaluation, bool store_parents,
+        successor_generator::SuccessorGeneratorType successor_generator_type,
         OperatorCost cost_type, int bound, double max_time,
         const std::string &description, utils::Verbosity verbosity);
 
@@ -65,9 +83,14 @@ extern void add_eager_search_options_to_feature(
     plugins::Feature &feature, const std::string &description);
 extern std::tuple<
     std::shared_ptr<TaskIndependentPruningMethod>,
-    std::shared_ptr<TaskIndependentEvaluator>, OperatorCost, int, double,
-    std::string, utils::Verbosity>
-get_eager_search_arguments_from_options(const plugins::Options &opts);
+    std::shared_ptr<TaskIndependentEvaluator>,
+    std::shared_ptr<TaskIndependentEvaluator>,
+    std::shared_ptr<parallel_evaluator::TaskIndependentParallelEvaluator>,
+    bool, bool, successor_generator::SuccessorGeneratorType, OperatorCost,
+    int, double, std::string, utils::Verbosity>
+get_eager_search_arguments_from_options(
+    const plugins::Options &opts,
+    const std::shared_ptr<TaskIndependentOpenListFactory> &open);
 }
 
 #endif
@@ -0,0 +1,563 @@
+#include "hdastar_search.h"
+
+#include "search_common.h"
+
+#include "../evaluation_context.h"
+#include "../per_state_information.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../tasks/delegating_task.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/markup.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hdastar_search {
+static const int64_t IDLE_THREAD = int64_t(1) << 40;
+
+struct HDAStarNodeInfo {
+    enum NodeStatus {
+        NEW = 0,
+        OPEN = 1,
+        CLOSED = 2,
+        DEAD_END = 3
+    };
+
+    NodeStatus status;
+    int g;
+    int real_g;
+    int h;
+    // Parents can belong to other threads.
+    int parent_thread;
+    StateID parent_state_id;
+    OperatorID creating_operator;
+
+    HDAStarNodeInfo()
+        : status(NEW),
+          g(-1),
+          real_g(-1),
+          h(-1),
+          parent_thread(-1),
+          parent_state_id(StateID::no_state),
+          creating_operator(OperatorID::no_operator) {
+    }
+};
+
+/*
+  Successors of one expanded state that belong to the same thread. They share
+  their parent, so we store the parent data only once.
+*/
+struct StateBatch {
+    StateBatch *next;
+    int parent_thread;
+    StateID parent_state_id;
+    int parent_g;
+    int parent_real_g;
+    vector<OperatorID> creating_operators;
+    // Packed data of all states, stored consecutively.
+    vector<PackedStateBin> state_data;
+
+    StateBatch(
+        int parent_thread, StateID parent_state_id, int parent_g,
+        int parent_real_g)
+        : next(nullptr),
+          parent_thread(parent_thread),
+          parent_state_id(parent_state_id),
+          parent_g(parent_g),
+          parent_real_g(parent_real_g) {
+    }
+};
+
+/*
+  Lock-free queue with many producers and a single consumer. Producers push
+  batches onto an intrusive stack with compare-and-swap. The consumer takes
+  all batches at once by exchanging the head with nullptr, which avoids the
+  ABA problem of popping single elements.
+*/
+class StateBatchQueue {
+    atomic<StateBatch *> head;
+public:
+    StateBatchQueue() : head(nullptr) {
+    }
+
+    ~StateBatchQueue() {
+        pop_all();
+    }
+
+    void push(unique_ptr<StateBatch> batch) {
+        StateBatch *new_head = batch.release();
+        new_head->next = head.load(memory_order_relaxed);
+        while (!head.compare_exchange_weak(
+            new_head->next, new_head, memory_order_release,
+            memory_order_relaxed)) {
+        }
+    }
+
+    // Return all batches in the order in which they were pushed.
+    vector<unique_ptr<StateBatch>> pop_all() {
+        vector<unique_ptr<StateBatch>> batches;
+        StateBatch *batch = head.exchange(nullptr, memory_order_acquire);
+        while (batch) {
+            StateBatch *next = batch->next;
+            batches.emplace_back(batch);
+            batch = next;
+        }
+        reverse(batches.begin(), batches.end());
+        return batches;
+    }
+};
+
+struct HDAStarSearch::SearchThread {
+    const int id;
+    const shared_ptr<AbstractTask> task;
+    const TaskProxy task_proxy;
+    StateRegistry state_registry;
+    const shared_ptr<Evaluator> heuristic;
+    const shared_ptr<OpenListFactory> open_list_factory;
+    const unique_ptr<StateOpenList> open_list;
+    PerStateInformation<HDAStarNodeInfo> search_node_infos;
+    utils::LogProxy log;
+    SearchStatistics statistics;
+
+    // Reused in every expansion to avoid allocations.
+    vector<OperatorID> applicable_ops;
+    vector<PackedStateBin> successor_data;
+
+    SearchThread(
+        int id, const shared_ptr<AbstractTask> &task,
+        const shared_ptr<TaskIndependentEvaluator> &eval,
+        const shared_ptr<TaskIndependentOpenListFactory> &open)
+        : id(id),
+          task(task),
+          task_proxy(*task),
+          state_registry(task_proxy),
+          heuristic(eval->bind_task(task)),
+          open_list_factory(open->bind_task(task)),
+          open_list(open_list_factory->create_state_open_list()),
+          log(utils::get_silent_log()),
+          statistics(log),
+          successor_data(state_registry.get_bins_per_state()) {
+    }
+};
+
+HDAStarSearch::HDAStarSearch(
+    const shared_ptr<AbstractTask> &task,
+    const shared_ptr<TaskIndependentEvaluator> &eval,
+    const shared_ptr<TaskIndependentOpenListFactory> &open, int num_threads,
+    OperatorCost cost_type, int bound, double max_time,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(task, cost_type, bound, max_time, description, verbosity),
+      num_threads(num_threads),
+      /*
+        The bound limits the real plan cost and is enforced on real_g when
+        generating successors. Only with normal costs is it also a bound on
+        the adjusted costs g + h that we compare against incumbent_cost.
+      */
+      incumbent_cost(cost_type == NORMAL ? bound : numeric_limits<int>::max()),
+      goal_thread(-1),
+      goal_state_id(StateID::no_state),
+      termination_counter(0),
+      stop_search(false),
+      timed_out(false) {
+    for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        /*
+          All threads except the first one use a new task object, so that
+          they get their own instances of all evaluators (and of the state
+          packer and axiom evaluator used by their state registry).
+        */
+        shared_ptr<AbstractTask> thread_task =
+            thread_id == 0 ? task : make_shared<tasks::DelegatingTask>(task);
+        threads.push_back(
+            make_unique<SearchThread>(thread_id, thread_task, eval, open));
+        queues.push_back(make_unique<StateBatchQueue>());
+    }
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+int HDAStarSearch::get_owner(const PackedStateBin *buffer) const {
+    return int_hash_set::get_partition(
+        threads[0]->state_registry.get_state_data_hash(buffer), num_threads);
+}
+
+void HDAStarSearch::insert_state(
+    SearchThread &thread, const PackedStateBin *buffer, int parent_thread,
+    StateID parent_state_id, int parent_g, int parent_real_g,
+    OperatorID op_id) {
+    State state = thread.state_registry.insert_state(buffer);
+    HDAStarNodeInfo &info = thread.search_node_infos[state];
+    OperatorProxy op = thread.task_proxy.get_operators()[op_id];
+    int g = parent_g + get_adjusted_cost(op);
+    if (info.status == HDAStarNodeInfo::DEAD_END ||
+        (info.status != HDAStarNodeInfo::NEW && info.g <= g)) {
+        return;
+    }
+
+    EvaluationContext eval_context(state, g, false, &thread.statistics);
+    if (info.status == HDAStarNodeInfo::NEW) {
+        thread.statistics.inc_evaluated_states();
+        if (thread.open_list->is_dead_end(eval_context) ||
+            eval_context.is_evaluator_value_infinite(thread.heuristic.get())) {
+            info.status = HDAStarNodeInfo::DEAD_END;
+            thread.statistics.inc_dead_ends();
+            return;
+        }
+        info.h = eval_context.get_evaluator_value(thread.heuristic.get());
+    } else if (info.status == HDAStarNodeInfo::CLOSED) {
+        thread.statistics.inc_reopened();
+    }
+    info.status = HDAStarNodeInfo::OPEN;
+    info.g = g;
+    info.real_g = parent_real_g + op.get_cost();
+    info.parent_thread = parent_thread;
+    info.parent_state_id = parent_state_id;
+    info.creating_operator = op_id;
+    if (g + info.h < incumbent_cost.load(memory_order_relaxed)) {
+        thread.open_list->insert(eval_context, state.get_id());
+    }
+}
+
+void HDAStarSearch::process_batch(
+    SearchThread &thread, const StateBatch &batch) {
+    int num_bins = thread.state_registry.get_bins_per_state();
+    for (size_t i = 0; i < batch.creating_operators.size(); ++i) {
+        insert_state(
+            thread, &batch.state_data[i * num_bins], batch.parent_thread,
+            batch.parent_state_id, batch.parent_g, batch.parent_real_g,
+            batch.creating_operators[i]);
+    }
+}
+
+void HDAStarSearch::expand(
+    SearchThread &thread, const State &state,
+    vector<unique_ptr<StateBatch>> &outgoing_batches) {
+    const HDAStarNodeInfo &info = thread.search_node_infos[state];
+    int g = info.g;
+    int real_g = info.real_g;
+
+    thread.applicable_ops.clear();
+    successor_generator.generate_applicable_ops(state, thread.applicable_ops);
+    thread.statistics.inc_generated_ops(thread.applicable_ops.size());
+
+    int num_bins = thread.state_registry.get_bins_per_state();
+    PackedStateBin *buffer = thread.successor_data.data();
+    for (OperatorID op_id : thread.applicable_ops) {
+        OperatorProxy op = thread.task_proxy.get_operators()[op_id];
+        if (real_g + op.get_cost() >= bound)
+            continue;
+
+        thread.state_registry.compute_successor_data(state, op, buffer);
+        thread.statistics.inc_generated();
+        int owner = get_owner(buffer);
+        if (owner == thread.id) {
+            insert_state(
+                thread, buffer, thread.id, state.get_id(), g, real_g, op_id);
+        } else {
+            unique_ptr<StateBatch> &batch = outgoing_batches[owner];
+            if (!batch) {
+                batch = make_unique<StateBatch>(
+                    thread.id, state.get_id(), g, real_g);
+            }
+            batch->creating_operators.push_back(op_id);
+            batch->state_data.insert(
+                batch->state_data.end(), buffer, buffer + num_bins);
+        }
+    }
+
+    for (int owner = 0; owner < num_threads; ++owner) {
+        if (outgoing_batches[owner]) {
+            // Count the batch as in transit before it becomes visible.
+            termination_counter.fetch_add(1);
+            queues[owner]->push(move(outgoing_batches[owner]));
+        }
+    }
+}
+
+bool HDAStarSearch::expand_next_state(
+    SearchThread &thread, vector<unique_ptr<StateBatch>> &outgoing_batches) {
+    while (!thread.open_list->empty()) {
+        StateID id = thread.open_list->remove_min();
+        State state = thread.state_registry.lookup_state(id);
+        HDAStarNodeInfo &info = thread.search_node_infos[state];
+        /*
+          Skip outdated open list entries and states that cannot lead to a
+          cheaper plan. Since the incumbent cost only decreases, we never
+          need these entries again. If a cheaper path to such a state is
+          found, it is inserted into the open list again.
+        */
+        if (info.status != HDAStarNodeInfo::OPEN ||
+            info.g + info.h >= incumbent_cost.load(memory_order_relaxed)) {
+            continue;
+        }
+
+        info.status = HDAStarNodeInfo::CLOSED;
+        thread.statistics.inc_expanded();
+        if (task_properties::is_goal_state(thread.task_proxy, state)) {
+            lock_guard<mutex> lock(goal_mutex);
+            if (info.g < incumbent_cost.load()) {
+                incumbent_cost.store(info.g);
+                goal_thread = thread.id;
+                goal_state_id = id;
+            }
+        } else {
+            expand(thread, state, outgoing_batches);
+        }
+        return true;
+    }
+    return false;
+}
+
+void HDAStarSearch::run_thread(
+    SearchThread &thread, const utils::CountdownTimer &timer) {
+    vector<unique_ptr<StateBatch>> outgoing_batches(num_threads);
+    bool idle = false;
+    try {
+        while (!stop_search.load(memory_order_relaxed)) {
+            if (thread.id == 0 && timer.is_expired()) {
+                timed_out = true;
+                stop_search = true;
+                break;
+            }
+
+            vector<unique_ptr<StateBatch>> batches =
+                queues[thread.id]->pop_all();
+            if (!batches.empty()) {
+                /*
+                  The batches are still counted as in transit, so no other
+                  thread can detect termination before we are busy again.
+                */
+                if (idle) {
+                    idle = false;
+                    termination_counter.fetch_sub(IDLE_THREAD);
+                }
+                for (const unique_ptr<StateBatch> &batch : batches) {
+                    process_batch(thread, *batch);
+                    termination_counter.fetch_sub(1);
+                }
+            }
+
+            if (expand_next_state(thread, outgoing_batches)) {
+                continue;
+            }
+
+            if (!idle) {
+                idle = true;
+                termination_counter.fetch_add(IDLE_THREAD);
+            }
+            if (termination_counter.load() == num_threads * IDLE_THREAD) {
+                stop_search = true;
+            } else {
+                this_thread::yield();
+            }
+        }
+    } catch (...) {
+        // Let the other threads stop before the exception is rethrown.
+        stop_search = true;
+        throw;
+    }
+}
+
+void HDAStarSearch::initialize() {
+    log << "Conducting hash-distributed A* search with " << num_threads
+        << " threads, (real) bound = " << bound << endl;
+
+    for (const unique_ptr<SearchThread> &thread : threads) {
+        set<Evaluator *> path_dependent_evaluators;
+        thread->heuristic->get_path_dependent_evaluators(
+            path_dependent_evaluators);
+        if (!path_dependent_evaluators.empty()) {
+            cerr << "HDA* does not support path-dependent evaluators" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+    }
+
+    const State &initial_state = state_registry.get_initial_state();
+    SearchThread &thread = *threads[get_owner(initial_state.get_buffer())];
+    State state =
+        thread.state_registry.insert_state(initial_state.get_buffer());
+    EvaluationContext eval_context(state, 0, true, &thread.statistics);
+    thread.statistics.inc_evaluated_states();
+    if (thread.open_list->is_dead_end(eval_context) ||
+        eval_context.is_evaluator_value_infinite(thread.heuristic.get())) {
+        log << "Initial state is a dead end." << endl;
+        return;
+    }
+    print_initial_evaluator_values(eval_context);
+
+    HDAStarNodeInfo &info = thread.search_node_infos[state];
+    info.status = HDAStarNodeInfo::OPEN;
+    info.g = 0;
+    info.real_g = 0;
+    info.h = eval_context.get_evaluator_value(thread.heuristic.get());
+    thread.open_list->insert(eval_context, state.get_id());
+}
+
+SearchStatus HDAStarSearch::step() {
+    utils::CountdownTimer timer(max_time);
+    {
+        utils::ThreadPool thread_pool(num_threads);
+        /*
+          The pool runs one task per thread. Each task only returns once the
+          search stops, so all tasks run concurrently.
+        */
+        thread_pool.run(num_threads, [&](int task_index, int) {
+            run_thread(*threads[task_index], timer);
+        });
+    }
+
+    for (const unique_ptr<SearchThread> &thread : threads) {
+        const SearchStatistics &thread_statistics = thread->statistics;
+        statistics.inc_expanded(thread_statistics.get_expanded());
+        statistics.inc_evaluated_states(
+            thread_statistics.get_evaluated_states());
+        statistics.inc_evaluations(thread_statistics.get_evaluations());
+        statistics.inc_generated(thread_statistics.get_generated());
+        statistics.inc_generated_ops(thread_statistics.get_generated_ops());
+        statistics.inc_reopened(thread_statistics.get_reopened());
+        statistics.inc_dead_ends(thread_statistics.get_dead_ends());
+    }
+
+    if (timed_out) {
+        return TIMEOUT;
+    }
+    if (goal_thread != -1) {
+        extract_plan();
+        return SOLVED;
+    }
+    log << "Completely explored state space -- no solution!" << endl;
+    return FAILED;
+}
+
+void HDAStarSearch::extract_plan() {
+    Plan plan;
+    int thread_id = goal_thread;
+    StateID state_id = goal_state_id;
+    for (;;) {
+        const SearchThread &thread = *threads[thread_id];
+        State state = thread.state_registry.lookup_state(state_id);
+        const HDAStarNodeInfo &info = thread.search_node_infos[state];
+        if (info.creating_operator == OperatorID::no_operator) {
+            assert(info.parent_state_id == StateID::no_state);
+            break;
+        }
+        plan.push_back(info.creating_operator);
+        thread_id = info.parent_thread;
+        state_id = info.parent_state_id;
+    }
+    reverse(plan.begin(), plan.end());
+    log << "Solution found!" << endl;
+    set_plan(plan);
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    int num_registered_states = 0;
+    for (const unique_ptr<SearchThread> &thread : threads) {
+        log << "Thread " << thread->id << ": "
+            << thread->statistics.get_expanded() << " expanded, "
+            << thread->state_registry.size() << " registered" << endl;
+        num_registered_states += thread->state_registry.size();
+    }
+    log << "Number of registered states: " << num_registered_states << endl;
+}
+
+class TaskIndependentHDAStarSearch
+    : public components::TaskIndependentComponent<SearchAlgorithm> {
+    shared_ptr<TaskIndependentEvaluator> eval;
+    shared_ptr<TaskIndependentOpenListFactory> open;
+    int num_threads;
+    OperatorCost cost_type;
+    int bound;
+    double max_time;
+    string description;
+    utils::Verbosity verbosity;
+protected:
+    virtual shared_ptr<SearchAlgorithm> create_task_specific_component(
+        const shared_ptr<AbstractTask> &task) const override {
+        return make_shared<HDAStarSearch>(
+            task, eval, open, num_threads, cost_type, bound, max_time,
+            description, verbosity);
+    }
+
+public:
+    TaskIndependentHDAStarSearch(
+        const shared_ptr<TaskIndependentEvaluator> &eval,
+        const shared_ptr<TaskIndependentOpenListFactory> &open,
+        int num_threads, OperatorCost cost_type, int bound, double max_time,
+        const string &description, utils::Verbosity verbosity)
+        : eval(eval),
+          open(open),
+          num_threads(num_threads),
+          cost_type(cost_type),
+          bound(bound),
+          max_time(max_time),
+          description(description),
+          verbosity(verbosity) {
+    }
+};
+
+class HDAStarSearchFeature
+    : public plugins::TypedFeature<TaskIndependentSearchAlgorithm> {
+public:
+    HDAStarSearchFeature() : TypedFeature("hdastar") {
+        document_title("Hash-distributed A* search");
+        document_synopsis(
+            "Parallel A* search that distributes the states among the threads "
+            "based on the hash values of the states. Each thread expands its "
+            "own states in A* order (g+h, ties broken by h) and sends "
+            "successors that belong to other threads to their owners. "
+            "Closed nodes are re-opened. With an admissible heuristic, the "
+            "search finds optimal plans. For details, see" +
+            utils::format_journal_reference(
+                {"Akihiro Kishimoto", "Alex Fukunaga", "Adi Botea"},
+                "Evaluation of a simple, scalable, parallel best-first search "
+                "strategy",
+                "https://doi.org/10.1016/j.artint.2012.10.007",
+                "Artificial Intelligence", "195", "222-248", "2013"));
+
+        add_option<shared_ptr<TaskIndependentEvaluator>>(
+            "eval", "evaluator for h-value");
+        add_option<int>(
+            "threads", "number of search threads", "1",
+            plugins::Bounds("1", "infinity"));
+        add_search_algorithm_options_to_feature(*this, "hdastar");
+
+        document_note(
+            "Threads",
+            "Each thread uses its own copy of the evaluator, so memory usage "
+            "and preprocessing time of the evaluator grow with the number of "
+            "threads. Path-dependent evaluators (e.g. landmark heuristics) are "
+            "not supported. The order of expansions depends on the scheduling "
+            "of the threads, so the number of expanded states and the plan "
+            "(but not its cost) can differ between runs. Note that max_time "
+            "and the reported times measure the CPU time of all threads.");
+    }
+
+    virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
+        const plugins::Options &opts) const override {
+        shared_ptr<TaskIndependentEvaluator> eval =
+            opts.get<shared_ptr<TaskIndependentEvaluator>>("eval");
+        shared_ptr<TaskIndependentOpenListFactory> open =
+            search_common::create_astar_open_list_factory_and_f_eval(
+                eval, opts.get<utils::Verbosity>("verbosity"))
+                .first;
+        return components::make_shared_from_arg_tuples<
+            TaskIndependentHDAStarSearch>(
+            eval, open, opts.get<int>("threads"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<HDAStarSearchFeature> _plugin;
+}
@@ -0,0 +1,92 @@
+#ifndef SEARCH_ALGORITHMS_HDASTAR_SEARCH_H
+#define SEARCH_ALGORITHMS_HDASTAR_SEARCH_H
+
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../search_algorithm.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace hdastar_search {
+struct StateBatch;
+class StateBatchQueue;
+
+/*
+  Hash-distributed A* (HDA*), see Kishimoto, Fukunaga and Botea, Evaluation
+  of a simple, scalable, parallel best-first search strategy (AIJ 2013).
+
+  Each thread owns the states whose packed data hashes to it. A thread has
+  its own state registry, search nodes, open list and evaluators and only
+  expands states it owns. Successors owned by other threads are sent to them
+  in batches through lock-free message queues. Since a node can be expanded
+  before another thread finds a cheaper path to it, closed nodes are always
+  reopened. The search ends when all threads are idle and no messages are in
+  transit. With an admissible heuristic, the plan is optimal.
+*/
+class HDAStarSearch : public SearchAlgorithm {
+    struct SearchThread;
+
+    const int num_threads;
+    std::vector<std::unique_ptr<SearchThread>> threads;
+    std::vector<std::unique_ptr<StateBatchQueue>> queues;
+
+    /*
+      Adjusted cost of the cheapest plan found so far (or the bound if no plan
+      has been found yet and we use normal costs). We only expand states with
+      g + h < incumbent_cost, where g and h are adjusted costs.
+    */
+    std::atomic<int> incumbent_cost;
+    std::mutex goal_mutex;
+    int goal_thread;
+    StateID goal_state_id;
+
+    /*
+      Number of idle threads (in the upper bits) and number of batches in
+      transit (in the lower bits). Keeping both in one word allows to detect
+      termination with a single load.
+    */
+    std::atomic<int64_t> termination_counter;
+    std::atomic<bool> stop_search;
+    std::atomic<bool> timed_out;
+
+    int get_owner(const PackedStateBin *buffer) const;
+    void insert_state(
+        SearchThread &thread, const PackedStateBin *buffer, int parent_thread,
+        StateID parent_state_id, int parent_g, int parent_real_g,
+        OperatorID op_id);
+    void process_batch(SearchThread &thread, const StateBatch &batch);
+    void expand(
+        SearchThread &thread, const State &state,
+        std::vector<std::unique_ptr<StateBatch>> &outgoing_batches);
+    bool expand_next_state(
+        SearchThread &thread,
+        std::vector<std::unique_ptr<StateBatch>> &outgoing_batches);
+    void run_thread(SearchThread &thread, const utils::CountdownTimer &timer);
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    HDAStarSearch(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::shared_ptr<TaskIndependentEvaluator> &eval,
+        const std::shared_ptr<TaskIndependentOpenListFactory> &open,
+        int num_threads, OperatorCost cost_type, int bound, double max_time,
+        const std::string &description, utils::Verbosity verbosity);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
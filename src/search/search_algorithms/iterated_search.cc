@@ -1,5 +1,7 @@
 #include "iterated_search.h"
 
+#include "portfolio_search.h"
+
 #include "../evaluator.h"
 
 #include "../landmarks/landmark_factory.h"
@@ -7,7 +9,9 @@
 #include "../utils/component_errors.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 using namespace std;
 
@@ -117,9 +121,15 @@ SearchStatus IteratedSearch::step() {
     if (!task_specific_search) {
         return found_solution() ? SOLVED : FAILED;
     }
+    // Concurrent searches may have lowered the bound (see search()).
+    best_bound = min(best_bound, bound);
     if (pass_bound && best_bound < task_specific_search->get_bound()) {
         task_specific_search->set_bound(best_bound);
     }
+    if (shared_incumbent) {
+        task_specific_search->set_concurrent_search_controls(
+            stop_flag, shared_incumbent);
+    }
     ++phase;
 
     task_specific_search->search();
@@ -132,7 +142,10 @@ SearchStatus IteratedSearch::step() {
         found_plan = task_specific_search->get_plan();
         plan_cost = calculate_plan_cost(found_plan, task_proxy);
         if (plan_cost < best_bound) {
-            plan_manager.save_plan(found_plan, task_proxy, true);
+            // With a shared incumbent, the incumbent saves the plans.
+            if (!shared_incumbent) {
+                plan_manager.save_plan(found_plan, task_proxy, true);
+            }
             best_bound = plan_cost;
             set_plan(found_plan);
         }
@@ -264,6 +277,11 @@ public:
         add_option<bool>(
             "continue_on_solve", "continue search after solution found",
             "true");
+        add_option<bool>(
+            "concurrent",
+            "run all phases at the same time, each in its own thread (see "
+            "note 3)",
+            "false");
         add_search_algorithm_options_to_feature(*this, "iterated");
 
         document_note(
@@ -286,10 +304,39 @@ public:
             "                        lazy_wastar([h],w=3), lazy_wastar([h],w=2),\n"
             "                        lazy_wastar([h],w=1)]))\"\n"
             "```");
+        document_note(
+            "Note 3",
+            "With concurrent=true, all phases start at once and share the "
+            "cost of the best plan found so far: whenever a phase finds a "
+            "cheaper plan, the other phases use its cost as their bound after "
+            "their next expansion. This is the same as a parallel portfolio "
+            "of the phases (see portfolio). With continue_on_solve=false, "
+            "all phases stop when the first plan is found. repeat_last, "
+            "pass_bound=false and continue_on_fail are not supported. Each "
+            "phase uses its own copy of all evaluators, so heuristic "
+            "predefinition does not avoid their preprocessing.");
     }
 
     virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
         const plugins::Options &opts) const override {
+        if (opts.get<bool>("concurrent")) {
+            utils::verify_argument(
+                !opts.get<bool>("repeat_last"),
+                "repeat_last=true is not supported with concurrent=true.");
+            utils::verify_argument(
+                opts.get<bool>("pass_bound"),
+                "pass_bound=false is not supported with concurrent=true.");
+            utils::verify_argument(
+                !opts.get<bool>("continue_on_fail"),
+                "continue_on_fail=true is not supported with concurrent=true.");
+            return components::make_shared_from_arg_tuples<
+                portfolio_search::TaskIndependentPortfolioSearch>(
+                opts.get_list<shared_ptr<TaskIndependentSearchAlgorithm>>(
+                    "algorithm_configs"),
+                opts.get<bool>("continue_on_solve"),
+                numeric_limits<int>::max(),
+                get_search_algorithm_arguments_from_options(opts));
+        }
         return components::make_shared_from_arg_tuples<
             TaskIndependentIteratedSearch>(
             opts.get_list<shared_ptr<TaskIndependentSearchAlgorithm>>(
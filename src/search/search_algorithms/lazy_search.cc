@@ -21,9 +21,10 @@ LazySearch::LazySearch(
     const shared_ptr<AbstractTask> &task,
     const shared_ptr<OpenListFactory> &open, bool reopen_closed,
     const vector<shared_ptr<Evaluator>> &preferred, bool randomize_successors,
-    bool preferred_successors_first, int random_seed, OperatorCost cost_type,
-    int bound, double max_time, const string &description,
-    utils::Verbosity verbosity)
+    bool preferred_successors_first, int random_seed,
+    const shared_ptr<Evaluator> &bound_evaluator, bool batch_evaluation,
+    OperatorCost cost_type, int bound, double max_time,
+    const string &description, utils::Verbosity verbosity)
     : SearchAlgorithm(task, cost_type, bound, max_time, description, verbosity),
       open_list(open->create_edge_open_list()),
       reopen_closed_nodes(reopen_closed),
@@ -31,6 +32,8 @@ LazySearch::LazySearch(
       preferred_successors_first(preferred_successors_first),
       rng(utils::get_rng(random_seed)),
       preferred_operator_evaluators(preferred),
+      bound_evaluator(bound_evaluator), // default nullptr
+      batch_evaluation(batch_evaluation),
       current_state(state_registry.get_initial_state()),
       current_predecessor_id(StateID::no_state),
       current_operator_id(OperatorID::no_operator),
@@ -58,11 +61,50 @@ void LazySearch::initialize() {
         evaluator->get_path_dependent_evaluators(evals);
     }
 
+    if (bound_evaluator) {
+        bound_evaluator->get_path_dependent_evaluators(evals);
+    }
+
     path_dependent_evaluators.assign(evals.begin(), evals.end());
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
     }
+
+    if (batch_evaluation && !path_dependent_evaluators.empty()) {
+        cerr << "path-dependent evaluators are not supported with batch "
+             << "evaluation" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    if (batch_evaluation) {
+        /*
+          When a state is expanded, evaluators with preferred operators
+          would only look up a cached estimate computed in a batch and not
+          compute the preferred operators. We therefore exclude them and
+          all evaluators that depend on them from batch evaluation.
+        */
+        vector<Evaluator *> candidates;
+        open_list->get_evaluators(candidates);
+        if (bound_evaluator) {
+            bound_evaluator->get_evaluators(candidates);
+        }
+        for (Evaluator *candidate : candidates) {
+            vector<Evaluator *> dependencies;
+            candidate->get_evaluators(dependencies);
+            bool uses_preferred_operators = any_of(
+                preferred_operator_evaluators.begin(),
+                preferred_operator_evaluators.end(),
+                [&](const shared_ptr<Evaluator> &evaluator) {
+                    return find(
+                               dependencies.begin(), dependencies.end(),
+                               evaluator.get()) != dependencies.end();
+                });
+            if (!uses_preferred_operators) {
+                batch_evaluators.push_back(candidate);
+            }
+        }
+    }
 }
 
 vector<OperatorID> LazySearch::get_successor_operators(
@@ -106,6 +148,9 @@ void LazySearch::generate_successors() {
 
     statistics.inc_generated(successor_operators.size());
 
+    if (batch_evaluation)
+        evaluate_new_successors(successor_operators, preferred_operators);
+
     for (OperatorID op_id : successor_operators) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         int new_g = current_g + get_adjusted_cost(op);
@@ -120,6 +165,38 @@ void LazySearch::generate_successors() {
     }
 }
 
+/*
+  Successors enter the open list with the estimates of their parent, so the
+  results of the batch are only reused through the estimate caches of the
+  evaluators when the successors are taken out of the open list.
+*/
+void LazySearch::evaluate_new_successors(
+    const vector<OperatorID> &successor_operators,
+    const ordered_set::OrderedSet<OperatorID> &preferred_operators) {
+    vector<EvaluationContext> successor_contexts;
+    successor_contexts.reserve(successor_operators.size());
+    for (OperatorID op_id : successor_operators) {
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        if (current_real_g + op.get_cost() >= bound)
+            continue;
+        State succ_state =
+            state_registry.get_successor_state(current_state, op);
+        if (search_space.get_node(succ_state).is_new()) {
+            successor_contexts.emplace_back(
+                succ_state, current_g + get_adjusted_cost(op),
+                preferred_operators.contains(op_id), &statistics);
+        }
+    }
+
+    vector<EvaluationContext *> new_contexts;
+    new_contexts.reserve(successor_contexts.size());
+    for (EvaluationContext &eval_context : successor_contexts)
+        new_contexts.push_back(&eval_context);
+    for (Evaluator *evaluator : batch_evaluators) {
+        evaluator->compute_batch_results(new_contexts);
+    }
+}
+
 SearchStatus LazySearch::fetch_next_state() {
     if (open_list->empty()) {
         log << "Completely explored state space -- no solution!" << endl;
@@ -185,6 +262,15 @@ SearchStatus LazySearch::step() {
             }
         }
         statistics.inc_evaluated_states();
+        /*
+          Successors are only evaluated when they are taken out of the open
+          list, so this is the earliest point where we can prune them. A
+          pruned node stays new, so its state is evaluated again whenever it
+          is reached.
+        */
+        if (prune_by_bound()) {
+            return fetch_next_state();
+        }
         if (!open_list->is_dead_end(current_eval_context)) {
             if (current_predecessor_id == StateID::no_state) {
                 node.open_initial();
@@ -227,12 +313,58 @@ SearchStatus LazySearch::step() {
     return fetch_next_state();
 }
 
+bool LazySearch::prune_by_bound() {
+    if (!bound_evaluator || current_predecessor_id == StateID::no_state) {
+        return false;
+    }
+    int h = current_eval_context.get_evaluator_value_or_infinity(
+        bound_evaluator.get());
+    if (h == EvaluationResult::INFTY || current_real_g + h >= bound) {
+        statistics.inc_pruned_by_bound();
+        return true;
+    }
+    return false;
+}
+
 void LazySearch::reward_progress() {
     open_list->boost_preferred();
 }
 
 void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
+    if (bound_evaluator) {
+        log << "Pruned by bound: " << statistics.get_pruned_by_bound()
+            << " state(s)." << endl;
+    }
     search_space.print_statistics();
+
+    vector<Evaluator *> evals;
+    open_list->get_evaluators(evals);
+    for (const shared_ptr<Evaluator> &evaluator :
+         preferred_operator_evaluators) {
+        evaluator->get_evaluators(evals);
+    }
+    if (bound_evaluator) {
+        bound_evaluator->get_evaluators(evals);
+    }
+    for (Evaluator *evaluator : evals) {
+        evaluator->print_statistics();
+    }
+}
+
+void add_batch_evaluation_option_to_feature(plugins::Feature &feature) {
+    feature.add_option<bool>(
+        "batch_evaluation",
+        "evaluate all new successors of an expanded state with one call to "
+        "each evaluator of the open list and the bound evaluator. Since "
+        "successors are only evaluated when they are taken out of the open "
+        "list otherwise, this evaluates and registers states that might never "
+        "be expanded. The results are reused through the estimate caches of "
+        "the evaluators, so this only pays off for evaluators with batch "
+        "implementations that cache their estimates. Evaluators used for "
+        "preferred operators (and evaluators combining them) are not "
+        "evaluated in batches, since their preferred operators have to be "
+        "computed when a state is expanded",
+        "false");
 }
 }
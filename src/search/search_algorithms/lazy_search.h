@@ -16,6 +16,10 @@
 
 class OpenListFactory;
 
+namespace plugins {
+class Feature;
+}
+
 namespace lazy_search {
 class LazySearch : public SearchAlgorithm {
 protected:
@@ -30,6 +34,10 @@ protected:
 
     std::vector<Evaluator *> path_dependent_evaluators;
     std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
+    std::shared_ptr<Evaluator> bound_evaluator;
+    bool batch_evaluation;
+    // Evaluators whose results are computed in batches (see initialize()).
+    std::vector<Evaluator *> batch_evaluators;
 
     State current_state;
     StateID current_predecessor_id;
@@ -42,9 +50,13 @@ protected:
     virtual SearchStatus step() override;
 
     void generate_successors();
+    void evaluate_new_successors(
+        const std::vector<OperatorID> &successor_operators,
+        const ordered_set::OrderedSet<OperatorID> &preferred_operators);
     SearchStatus fetch_next_state();
 
     void reward_progress();
+    bool prune_by_bound();
 
     std::vector<OperatorID> get_successor_operators(
         const ordered_set::OrderedSet<OperatorID> &preferred_operators) const;
@@ -55,11 +67,15 @@ public:
         const std::shared_ptr<OpenListFactory> &open, bool reopen_closed,
         const std::vector<std::shared_ptr<Evaluator>> &evaluators,
         bool randomize_successors, bool preferred_successors_first,
-        int random_seed, OperatorCost cost_type, int bound, double max_time,
+        int random_seed, const std::shared_ptr<Evaluator> &bound_evaluator,
+        bool batch_evaluation, OperatorCost cost_type, int bound,
+        double max_time,
         const std::string &description, utils::Verbosity verbosity);
 
     virtual void print_statistics() const override;
 };
+
+extern void add_batch_evaluation_option_to_feature(plugins::Feature &feature);
 }
 
 #endif
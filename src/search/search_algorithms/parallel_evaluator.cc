@@ -0,0 +1,132 @@
+#include "parallel_evaluator.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+
+#include "../tasks/delegating_task.h"
+
+#include <cassert>
+#include <optional>
+
+using namespace std;
+
+namespace parallel_evaluator {
+ParallelEvaluator::ParallelEvaluator(
+    const shared_ptr<AbstractTask> &task,
+    const shared_ptr<TaskIndependentOpenListFactory> &open_list_factory,
+    int num_threads)
+    : TaskSpecificComponent(task),
+      open_list_factory(open_list_factory),
+      thread_pool(num_threads) {
+    assert(num_threads >= 1);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        /*
+          Binding to a new task object guarantees that the component cache
+          creates new instances of all task-specific components instead of
+          reusing the ones of the search algorithm.
+        */
+        shared_ptr<AbstractTask> thread_task =
+            make_shared<tasks::DelegatingTask>(task);
+        shared_ptr<OpenListFactory> factory =
+            open_list_factory->bind_task(thread_task);
+        thread_open_lists.push_back(factory->create_state_open_list());
+        thread_open_list_factories.push_back(factory);
+        thread_tasks.push_back(thread_task);
+    }
+}
+
+void ParallelEvaluator::initialize(const State &initial_state) {
+    vector<components::TaskIndependentComponentBase *> ti_components;
+    ti_components.push_back(open_list_factory.get());
+    open_list_factory->get_task_preserving_subcomponents(ti_components);
+
+    search_evaluators_by_thread_evaluator.resize(thread_tasks.size());
+    for (size_t i = 0; i < thread_tasks.size(); ++i) {
+        for (components::TaskIndependentComponentBase *ti_component :
+             ti_components) {
+            shared_ptr<components::TaskSpecificComponent> search_component =
+                ti_component->get_cached(task);
+            shared_ptr<components::TaskSpecificComponent> thread_component =
+                ti_component->get_cached(thread_tasks[i]);
+            Evaluator *search_evaluator =
+                dynamic_cast<Evaluator *>(search_component.get());
+            const Evaluator *thread_evaluator =
+                dynamic_cast<const Evaluator *>(thread_component.get());
+            if (search_evaluator && thread_evaluator) {
+                search_evaluators_by_thread_evaluator[i][thread_evaluator] =
+                    search_evaluator;
+            }
+        }
+
+        EvaluationContext eval_context(initial_state, 0, true, nullptr);
+        thread_open_lists[i]->is_dead_end(eval_context);
+    }
+}
+
+void ParallelEvaluator::evaluate(
+    StateOpenList &open_list,
+    const vector<EvaluationContext *> &eval_contexts) {
+    int num_contexts = eval_contexts.size();
+    vector<int> evaluating_thread(num_contexts, 0);
+    vector<optional<EvaluatorCache>> thread_results(num_contexts);
+
+    thread_pool.run(num_contexts, [&](int index, int thread_id) {
+        EvaluationContext &eval_context = *eval_contexts[index];
+        if (thread_id == 0) {
+            open_list.is_dead_end(eval_context);
+        } else {
+            EvaluationContext thread_eval_context(
+                eval_context.get_state(), eval_context.get_g_value(),
+                eval_context.is_preferred(), nullptr);
+            thread_open_lists[thread_id - 1]->is_dead_end(
+                thread_eval_context);
+            evaluating_thread[index] = thread_id;
+            thread_results[index] = thread_eval_context.get_cache();
+        }
+    });
+
+    /*
+      We transfer the results in the calling thread because storing them
+      updates the search statistics.
+    */
+    for (int index = 0; index < num_contexts; ++index) {
+        if (!thread_results[index]) {
+            continue;
+        }
+        const utils::HashMap<const Evaluator *, Evaluator *>
+            &search_evaluators = search_evaluators_by_thread_evaluator
+                [evaluating_thread[index] - 1];
+        EvaluationContext &eval_context = *eval_contexts[index];
+        thread_results[index]->for_each_evaluator_result(
+            [&](const Evaluator *thread_evaluator,
+                const EvaluationResult &result) {
+                auto it = search_evaluators.find(thread_evaluator);
+                if (it != search_evaluators.end()) {
+                    eval_context.set_result(it->second, result);
+                }
+            });
+    }
+}
+
+TaskIndependentParallelEvaluator::TaskIndependentParallelEvaluator(
+    const shared_ptr<TaskIndependentOpenListFactory> &open_list_factory,
+    int num_threads)
+    : open_list_factory(open_list_factory), num_threads(num_threads) {
+}
+
+shared_ptr<ParallelEvaluator>
+TaskIndependentParallelEvaluator::create_task_specific_component(
+    const shared_ptr<AbstractTask> &task) const {
+    return make_shared<ParallelEvaluator>(task, open_list_factory, num_threads);
+}
+
+shared_ptr<TaskIndependentParallelEvaluator> create_parallel_evaluator(
+    const shared_ptr<TaskIndependentOpenListFactory> &open_list_factory,
+    int num_threads) {
+    if (num_threads == 1) {
+        return nullptr;
+    }
+    return make_shared<TaskIndependentParallelEvaluator>(
+        open_list_factory, num_threads);
+}
+}
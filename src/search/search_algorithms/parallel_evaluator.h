@@ -0,0 +1,105 @@
+#ifndef SEARCH_ALGORITHMS_PARALLEL_EVALUATOR_H
+#define SEARCH_ALGORITHMS_PARALLEL_EVALUATOR_H
+
+#include "../component.h"
+#include "../open_list.h"
+#include "../open_list_factory.h"
+
+#include "../utils/hash.h"
+#include "../utils/thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+class EvaluationContext;
+class Evaluator;
+class State;
+
+namespace parallel_evaluator {
+/*
+  Evaluate batches of evaluation contexts with a pool of threads.
+
+  The calling thread evaluates contexts with the open list of the search
+  algorithm. Each additional thread owns its own copy of this open list and
+  of all evaluators it uses. We obtain these copies by binding the
+  task-independent open list factory to a separate DelegatingTask per thread,
+  so that evaluators with mutable internal data structures (like most
+  heuristics) never share an instance between threads. Results computed by
+  these copies are stored in the given evaluation contexts under the
+  corresponding evaluators of the search algorithm, so the search can insert
+  the states into its own open list without recomputing anything.
+
+  We only evaluate what the open list needs to decide whether a state is a
+  dead end (which usually means all of its evaluators). Evaluators whose
+  results are not transferred are evaluated lazily by the calling thread as
+  usual. Since the thread copies are not notified of state transitions and do
+  not share per-state data with the evaluators of the search, path-dependent
+  evaluators are not supported.
+*/
+class ParallelEvaluator : public components::TaskSpecificComponent {
+    const std::shared_ptr<TaskIndependentOpenListFactory> open_list_factory;
+    utils::ThreadPool thread_pool;
+
+    // The following vectors have one entry for each additional thread.
+    std::vector<std::shared_ptr<AbstractTask>> thread_tasks;
+    std::vector<std::shared_ptr<OpenListFactory>> thread_open_list_factories;
+    std::vector<std::unique_ptr<StateOpenList>> thread_open_lists;
+    std::vector<utils::HashMap<const Evaluator *, Evaluator *>>
+        search_evaluators_by_thread_evaluator;
+
+public:
+    ParallelEvaluator(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::shared_ptr<TaskIndependentOpenListFactory>
+            &open_list_factory,
+        int num_threads);
+
+    /*
+      Must be called after the open list factory has been bound to the task of
+      the search algorithm and before the first call to evaluate(). The
+      initial state is evaluated once by every thread copy in the calling
+      thread, so that lazily initialized data (e.g. per-state information
+      subscribing to the state registry) is set up before threads access it.
+    */
+    void initialize(const State &initial_state);
+
+    /*
+      Evaluate all given contexts as far as needed for
+      open_list.is_dead_end(). The contexts must belong to distinct objects
+      and their states must not be modified (e.g. by registering new states
+      in their registry) while this method runs.
+    */
+    void evaluate(
+        StateOpenList &open_list,
+        const std::vector<EvaluationContext *> &eval_contexts);
+
+    int get_num_threads() const {
+        return thread_pool.get_num_threads();
+    }
+};
+
+class TaskIndependentParallelEvaluator
+    : public components::TaskIndependentComponent<ParallelEvaluator> {
+    std::shared_ptr<TaskIndependentOpenListFactory> open_list_factory;
+    int num_threads;
+
+    virtual std::shared_ptr<ParallelEvaluator> create_task_specific_component(
+        const std::shared_ptr<AbstractTask> &task) const override;
+public:
+    TaskIndependentParallelEvaluator(
+        const std::shared_ptr<TaskIndependentOpenListFactory>
+            &open_list_factory,
+        int num_threads);
+};
+
+/*
+  Return a parallel evaluator for the given open list factory, or nullptr if
+  only one thread should be used.
+*/
+extern std::shared_ptr<TaskIndependentParallelEvaluator>
+create_parallel_evaluator(
+    const std::shared_ptr<TaskIndependentOpenListFactory> &open_list_factory,
+    int num_threads);
+}
+
+#endif
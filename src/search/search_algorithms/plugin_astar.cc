@@ -53,17 +53,18 @@ public:
         vector<shared_ptr<TaskIndependentEvaluator>> preferred_list;
         options_copy.set("preferred", preferred_list);
 
+        shared_ptr<TaskIndependentOpenListFactory> open =
+            options_copy.get<shared_ptr<TaskIndependentOpenListFactory>>(
+                "open");
         return components::make_auto_task_independent_component<
             eager_search::EagerSearch, SearchAlgorithm>(
-            options_copy.get<shared_ptr<TaskIndependentOpenListFactory>>(
-                "open"),
-            options_copy.get<bool>("reopen_closed"),
+            open, options_copy.get<bool>("reopen_closed"),
             options_copy.get<shared_ptr<TaskIndependentEvaluator>>(
                 "f_eval", nullptr),
             options_copy.get_list<shared_ptr<TaskIndependentEvaluator>>(
                 "preferred"),
             eager_search::get_eager_search_arguments_from_options(
-                options_copy));
+                options_copy, open));
     }
 };
 
@@ -28,13 +28,14 @@ public:
 
     virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
         const plugins::Options &opts) const override {
+        shared_ptr<TaskIndependentOpenListFactory> open =
+            opts.get<shared_ptr<TaskIndependentOpenListFactory>>("open");
         return components::make_auto_task_independent_component<
             eager_search::EagerSearch, SearchAlgorithm>(
-            opts.get<shared_ptr<TaskIndependentOpenListFactory>>("open"),
-            opts.get<bool>("reopen_closed"),
+            open, opts.get<bool>("reopen_closed"),
             opts.get<shared_ptr<TaskIndependentEvaluator>>("f_eval", nullptr),
             opts.get_list<shared_ptr<TaskIndependentEvaluator>>("preferred"),
-            eager_search::get_eager_search_arguments_from_options(opts));
+            eager_search::get_eager_search_arguments_from_options(opts, open));
     }
 };
 
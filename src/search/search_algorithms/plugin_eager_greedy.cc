@@ -59,16 +59,17 @@ public:
 
     virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
         const plugins::Options &opts) const override {
-        return components::make_auto_task_independent_component<
-            eager_search::EagerSearch, SearchAlgorithm>(
+        shared_ptr<TaskIndependentOpenListFactory> open =
             search_common::create_greedy_open_list_factory(
                 opts.get_list<shared_ptr<TaskIndependentEvaluator>>("evals"),
                 opts.get_list<shared_ptr<TaskIndependentEvaluator>>(
                     "preferred"),
-                opts.get<int>("boost")),
-            false, shared_ptr<TaskIndependentEvaluator>(nullptr),
+                opts.get<int>("boost"));
+        return components::make_auto_task_independent_component<
+            eager_search::EagerSearch, SearchAlgorithm>(
+            open, false, shared_ptr<TaskIndependentEvaluator>(nullptr),
             opts.get_list<shared_ptr<TaskIndependentEvaluator>>("preferred"),
-            eager_search::get_eager_search_arguments_from_options(opts));
+            eager_search::get_eager_search_arguments_from_options(opts, open));
     }
 };
 
@@ -38,18 +38,19 @@ public:
 
     virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
         const plugins::Options &opts) const override {
-        return components::make_auto_task_independent_component<
-            eager_search::EagerSearch, SearchAlgorithm>(
+        shared_ptr<TaskIndependentOpenListFactory> open =
             search_common::create_wastar_open_list_factory(
                 opts.get_list<shared_ptr<TaskIndependentEvaluator>>("evals"),
                 opts.get_list<shared_ptr<TaskIndependentEvaluator>>(
                     "preferred"),
                 opts.get<int>("boost"), opts.get<int>("w"),
-                opts.get<utils::Verbosity>("verbosity")),
-            opts.get<bool>("reopen_closed"),
+                opts.get<utils::Verbosity>("verbosity"));
+        return components::make_auto_task_independent_component<
+            eager_search::EagerSearch, SearchAlgorithm>(
+            open, opts.get<bool>("reopen_closed"),
             opts.get<shared_ptr<TaskIndependentEvaluator>>("f_eval", nullptr),
             opts.get_list<shared_ptr<TaskIndependentEvaluator>>("preferred"),
-            eager_search::get_eager_search_arguments_from_options(opts));
+            eager_search::get_eager_search_arguments_from_options(opts, open));
     }
 };
 
@@ -19,6 +19,8 @@ public:
         add_list_option<shared_ptr<TaskIndependentEvaluator>>(
             "preferred", "use preferred operators of these evaluators", "[]");
         add_successors_order_options_to_feature(*this);
+        add_bound_evaluator_option_to_feature(*this);
+        lazy_search::add_batch_evaluation_option_to_feature(*this);
         add_search_algorithm_options_to_feature(*this, "lazy");
     }
 
@@ -30,6 +32,8 @@ public:
             opts.get<bool>("reopen_closed"),
             opts.get_list<shared_ptr<TaskIndependentEvaluator>>("preferred"),
             get_successors_order_arguments_from_options(opts),
+            get_bound_evaluator_arguments_from_options(opts),
+            opts.get<bool>("batch_evaluation"),
             get_search_algorithm_arguments_from_options(opts));
     }
 };
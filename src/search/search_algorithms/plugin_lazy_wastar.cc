@@ -27,6 +27,8 @@ public:
         add_option<int>(
             "w", "evaluator weight", "1", plugins::Bounds("0", "infinity"));
         add_successors_order_options_to_feature(*this);
+        add_bound_evaluator_option_to_feature(*this);
+        lazy_search::add_batch_evaluation_option_to_feature(*this);
         add_search_algorithm_options_to_feature(*this, "lazy_wastar");
 
         document_note(
@@ -82,6 +84,8 @@ public:
             opts.get<bool>("reopen_closed"),
             opts.get_list<shared_ptr<TaskIndependentEvaluator>>("preferred"),
             get_successors_order_arguments_from_options(opts),
+            get_bound_evaluator_arguments_from_options(opts),
+            opts.get<bool>("batch_evaluation"),
             get_search_algorithm_arguments_from_options(opts));
     }
 };
@@ -0,0 +1,297 @@
+#include "portfolio_search.h"
+
+#include "../plugins/plugin.h"
+#include "../tasks/delegating_task.h"
+#include "../utils/component_errors.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/system.h"
+#include "../utils/thread_pool.h"
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace portfolio_search {
+// How often the monitor checks the time, the memory and the incumbent.
+static const chrono::milliseconds MONITOR_INTERVAL(10);
+
+PortfolioSearch::Member::Member(const shared_ptr<SearchAlgorithm> &search)
+    : description(search->get_description()),
+      search(search),
+      stop_flag(false),
+      finished(false),
+      status(IN_PROGRESS) {
+}
+
+PortfolioSearch::PortfolioSearch(
+    const shared_ptr<AbstractTask> &task,
+    const vector<shared_ptr<TaskIndependentSearchAlgorithm>> &algorithm_configs,
+    bool continue_on_solve, int memory_limit, OperatorCost cost_type,
+    int bound, double max_time, const string &description,
+    utils::Verbosity verbosity)
+    : SearchAlgorithm(task, cost_type, bound, max_time, description, verbosity),
+      continue_on_solve(continue_on_solve),
+      memory_limit(
+          memory_limit == numeric_limits<int>::max() ? -1 : memory_limit),
+      num_finished_members(0),
+      timed_out(false) {
+    utils::verify_list_not_empty(algorithm_configs, "algorithm_configs");
+    for (size_t i = 0; i < algorithm_configs.size(); ++i) {
+        /*
+          All members except the first one use a new task object, so that
+          they get their own instances of all evaluators (and of the state
+          packer and axiom evaluator used by their state registry). The
+          components are bound here since binding is not thread-safe.
+        */
+        shared_ptr<AbstractTask> member_task =
+            i == 0 ? task : make_shared<tasks::DelegatingTask>(task);
+        members.push_back(
+            make_unique<Member>(algorithm_configs[i]->bind_task(member_task)));
+        log << "Portfolio member " << i << ": " << members.back()->description
+            << endl;
+    }
+}
+
+PortfolioSearch::~PortfolioSearch() {
+}
+
+void PortfolioSearch::initialize() {
+    log << "Running " << members.size()
+        << " search algorithms in parallel, (real) bound = " << bound << endl;
+    incumbent = make_unique<SharedIncumbent>(bound);
+    if (continue_on_solve) {
+        incumbent->save_improving_plans(plan_manager);
+    }
+    for (const unique_ptr<Member> &member : members) {
+        if (bound < member->search->get_bound()) {
+            member->search->set_bound(bound);
+        }
+        member->search->set_concurrent_search_controls(
+            &member->stop_flag, incumbent.get());
+    }
+}
+
+void PortfolioSearch::stop_all_members() {
+    for (const unique_ptr<Member> &member : members) {
+        member->stop_flag = true;
+    }
+}
+
+void PortfolioSearch::finish_member(Member &member) {
+    /*
+      Destroy the member before reporting it as finished, so that the
+      monitor sees the memory that it releases.
+    */
+    SearchStatus status = member.search->get_status();
+    member.search = nullptr;
+    lock_guard<mutex> lock(finished_mutex);
+    member.finished = true;
+    member.status = status;
+    ++num_finished_members;
+    member_finished.notify_one();
+}
+
+void PortfolioSearch::run_member(Member &member) {
+    try {
+        member.search->search();
+        member.search->print_statistics();
+        lock_guard<mutex> lock(finished_mutex);
+        const SearchStatistics &member_statistics =
+            member.search->get_statistics();
+        statistics.inc_expanded(member_statistics.get_expanded());
+        statistics.inc_evaluated_states(
+            member_statistics.get_evaluated_states());
+        statistics.inc_evaluations(member_statistics.get_evaluations());
+        statistics.inc_generated(member_statistics.get_generated());
+        statistics.inc_generated_ops(member_statistics.get_generated_ops());
+        statistics.inc_reopened(member_statistics.get_reopened());
+        statistics.inc_dead_ends(member_statistics.get_dead_ends());
+    } catch (...) {
+        // Let the other members stop before the exception is rethrown.
+        stop_all_members();
+        finish_member(member);
+        throw;
+    }
+    finish_member(member);
+}
+
+void PortfolioSearch::stop_member_for_memory(int &stopped_member) {
+    if (stopped_member != -1 && !members[stopped_member]->finished) {
+        // Wait until the memory of the last stopped member is released.
+        return;
+    }
+    int num_members = members.size();
+    if (num_members - num_finished_members <= 1 ||
+        utils::get_resident_memory_in_kb() / 1024 <= memory_limit) {
+        return;
+    }
+    for (int i = num_members - 1; i >= 0; --i) {
+        if (!members[i]->finished) {
+            log << "Memory limit reached. Stopping portfolio member " << i
+                << ": " << members[i]->description << endl;
+            members[i]->stop_flag = true;
+            stopped_member = i;
+            return;
+        }
+    }
+}
+
+void PortfolioSearch::monitor_members(const utils::CountdownTimer &timer) {
+    int num_members = members.size();
+    int stopped_member = -1;
+    unique_lock<mutex> lock(finished_mutex);
+    while (num_finished_members < num_members) {
+        member_finished.wait_for(lock, MONITOR_INTERVAL);
+        if (timer.is_expired() && !timed_out) {
+            log << "Time limit reached. Stopping all portfolio members."
+                << endl;
+            timed_out = true;
+            stop_all_members();
+        }
+        // Stop if this portfolio itself runs in a parallel portfolio.
+        if (stop_flag && stop_flag->load(memory_order_relaxed)) {
+            stop_all_members();
+        }
+        if (!continue_on_solve && incumbent->get_cost() < bound) {
+            stop_all_members();
+        }
+        if (memory_limit != -1) {
+            stop_member_for_memory(stopped_member);
+        }
+    }
+}
+
+SearchStatus PortfolioSearch::step() {
+    utils::CountdownTimer timer(max_time);
+    int num_members = members.size();
+    {
+        /*
+          The pool runs one task per member and one for the monitor. Each
+          task only returns once its member or all members are finished, so
+          all tasks run concurrently.
+        */
+        utils::ThreadPool thread_pool(num_members + 1);
+        thread_pool.run(num_members + 1, [&](int task_index, int) {
+            if (task_index == num_members) {
+                monitor_members(timer);
+            } else {
+                run_member(*members[task_index]);
+            }
+        });
+    }
+
+    if (incumbent->has_plan()) {
+        set_plan(incumbent->get_plan());
+        log << "Best solution cost: " << incumbent->get_cost() << endl;
+        return SOLVED;
+    }
+    if (timed_out) {
+        return TIMEOUT;
+    }
+    for (const unique_ptr<Member> &member : members) {
+        if (member->status != FAILED) {
+            return TIMEOUT;
+        }
+    }
+    log << "No portfolio member found a solution." << endl;
+    return FAILED;
+}
+
+void PortfolioSearch::save_plan_if_necessary() {
+    // In anytime mode, the incumbent saves each improving plan.
+    if (!continue_on_solve) {
+        SearchAlgorithm::save_plan_if_necessary();
+    }
+}
+
+void PortfolioSearch::print_statistics() const {
+    log << "Cumulative statistics:" << endl;
+    statistics.print_detailed_statistics();
+}
+
+TaskIndependentPortfolioSearch::TaskIndependentPortfolioSearch(
+    const vector<shared_ptr<TaskIndependentSearchAlgorithm>> &algorithm_configs,
+    bool continue_on_solve, int memory_limit, OperatorCost cost_type,
+    int bound, double max_time, const string &description,
+    utils::Verbosity verbosity)
+    : algorithm_configs(algorithm_configs),
+      continue_on_solve(continue_on_solve),
+      memory_limit(memory_limit),
+      cost_type(cost_type),
+      bound(bound),
+      max_time(max_time),
+      description(description),
+      verbosity(verbosity) {
+}
+
+shared_ptr<SearchAlgorithm>
+TaskIndependentPortfolioSearch::create_task_specific_component(
+    const shared_ptr<AbstractTask> &task) const {
+    return make_shared<PortfolioSearch>(
+        task, algorithm_configs, continue_on_solve, memory_limit, cost_type,
+        bound, max_time, description, verbosity);
+}
+
+class PortfolioSearchFeature
+    : public plugins::TypedFeature<TaskIndependentSearchAlgorithm> {
+public:
+    PortfolioSearchFeature() : TypedFeature("portfolio") {
+        document_title("Parallel portfolio");
+        document_synopsis(
+            "Runs several search algorithms at the same time, each in its own "
+            "thread. All members share the cost of the best plan found so far "
+            "and use it as their bound.");
+
+        add_list_option<shared_ptr<TaskIndependentSearchAlgorithm>>(
+            "algorithm_configs",
+            "search algorithms that are run in parallel, in decreasing order "
+            "of priority",
+            "");
+        add_option<bool>(
+            "continue_on_solve",
+            "keep searching for cheaper plans after a plan has been found. "
+            "Each plan that is cheaper than all previous ones is saved in a "
+            "new plan file. If false, all members are stopped when the first "
+            "plan is found.",
+            "false");
+        add_option<int>(
+            "memory_limit",
+            "limit for the resident memory of the whole planner process in "
+            "MiB. When it is exceeded, the members are stopped one at a "
+            "time, starting with the last one in the list, until the limit is "
+            "met again or only one member is left",
+            "infinity", plugins::Bounds("1", "infinity"));
+        add_search_algorithm_options_to_feature(*this, "portfolio");
+
+        document_note(
+            "Threads",
+            "Each member uses its own copy of the task and of all its "
+            "evaluators, so memory usage and preprocessing time grow with the "
+            "number of members. Members that use randomization should set "
+            "random_seed, because the global random number generator is not "
+            "thread-safe. The log output of the members is interleaved. Note "
+            "that max_time and the reported times measure the CPU time of "
+            "all threads.");
+        document_note(
+            "Anytime members",
+            "Iterated searches in the portfolio pass the shared bound on to "
+            "their phases, so a plan found by one member immediately prunes "
+            "the search of all other members. For anytime portfolios, use "
+            "continue_on_solve=true.");
+    }
+
+    virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
+        const plugins::Options &opts) const override {
+        return components::make_shared_from_arg_tuples<
+            TaskIndependentPortfolioSearch>(
+            opts.get_list<shared_ptr<TaskIndependentSearchAlgorithm>>(
+                "algorithm_configs"),
+            opts.get<bool>("continue_on_solve"), opts.get<int>("memory_limit"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<PortfolioSearchFeature> _plugin;
+}
@@ -0,0 +1,109 @@
+#ifndef SEARCH_ALGORITHMS_PORTFOLIO_SEARCH_H
+#define SEARCH_ALGORITHMS_PORTFOLIO_SEARCH_H
+
+#include "../search_algorithm.h"
+#include "../shared_incumbent.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace portfolio_search {
+/*
+  Parallel portfolio that runs several search algorithms concurrently, one
+  thread per member. Like the threads of HDA*, each member works on its own
+  copy of the task, so it has its own state registry and evaluators.
+
+  All members report their plans to a shared incumbent and use its cost as
+  their bound. Without continue_on_solve, all members are stopped as soon as
+  the first plan is found. Otherwise, the members keep searching for cheaper
+  plans and the incumbent saves each improving plan like an anytime search.
+
+  A monitor thread enforces the time limit of the portfolio and an optional
+  memory limit. If the resident memory of the process exceeds the limit,
+  the monitor stops the last member in the list that is still running,
+  waits until its memory is released and then checks again. The last
+  running member is never stopped for memory reasons. We don't limit the
+  address space (VmSize), because memory reserved by allocators and thread
+  stacks is rarely given back, so it barely shrinks when a member stops.
+*/
+class PortfolioSearch : public SearchAlgorithm {
+    struct Member {
+        std::string description;
+        std::shared_ptr<SearchAlgorithm> search;
+        std::atomic<bool> stop_flag;
+        // The following members are protected by finished_mutex.
+        bool finished;
+        SearchStatus status;
+
+        Member(const std::shared_ptr<SearchAlgorithm> &search);
+    };
+
+    std::vector<std::unique_ptr<Member>> members;
+    bool continue_on_solve;
+    // In MiB, or -1 for no limit.
+    int memory_limit;
+    std::unique_ptr<SharedIncumbent> incumbent;
+
+    std::mutex finished_mutex;
+    std::condition_variable member_finished;
+    // The following members are protected by finished_mutex.
+    int num_finished_members;
+    bool timed_out;
+
+    void stop_all_members();
+    void finish_member(Member &member);
+    void run_member(Member &member);
+    void stop_member_for_memory(int &stopped_member);
+    void monitor_members(const utils::CountdownTimer &timer);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    PortfolioSearch(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::vector<std::shared_ptr<TaskIndependentSearchAlgorithm>>
+            &algorithm_configs,
+        bool continue_on_solve, int memory_limit, OperatorCost cost_type,
+        int bound, double max_time, const std::string &description,
+        utils::Verbosity verbosity);
+    virtual ~PortfolioSearch() override;
+
+    virtual void save_plan_if_necessary() override;
+    virtual void print_statistics() const override;
+};
+
+class TaskIndependentPortfolioSearch
+    : public components::TaskIndependentComponent<SearchAlgorithm> {
+    std::vector<std::shared_ptr<TaskIndependentSearchAlgorithm>>
+        algorithm_configs;
+    bool continue_on_solve;
+    int memory_limit;
+    OperatorCost cost_type;
+    int bound;
+    double max_time;
+    std::string description;
+    utils::Verbosity verbosity;
+protected:
+    virtual std::shared_ptr<SearchAlgorithm> create_task_specific_component(
+        const std::shared_ptr<AbstractTask> &task) const override;
+
+public:
+    TaskIndependentPortfolioSearch(
+        const std::vector<std::shared_ptr<TaskIndependentSearchAlgorithm>>
+            &algorithm_configs,
+        bool continue_on_solve, int memory_limit, OperatorCost cost_type,
+        int bound, double max_time, const std::string &description,
+        utils::Verbosity verbosity);
+};
+}
+
+#endif
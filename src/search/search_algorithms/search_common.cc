@@ -5,7 +5,7 @@
 #include "../evaluators/weighted_evaluator.h"
 #include "../open_lists/alternation_open_list.h"
 #include "../open_lists/best_first_open_list.h"
-#include "../open_lists/tiebreaking_open_list.h"
+#include "../open_lists/bucket_open_list.h"
 #include "../utils/component_errors.h"
 
 #include <memory>
@@ -118,12 +118,10 @@ create_astar_open_list_factory_and_f_eval(
         components::make_auto_task_independent_component<SumEval, Evaluator>(
             vector<shared_ptr<TaskIndependentEvaluator>>({g, h_eval}),
             "astar.f_eval", verbosity);
-    vector<shared_ptr<TaskIndependentEvaluator>> evals = {f, h_eval};
-
     shared_ptr<TaskIndependentOpenListFactory> open =
         components::make_auto_task_independent_component<
-            tiebreaking_open_list::TieBreakingOpenListFactory, OpenListFactory>(
-            evals, false, false);
+            bucket_open_list::BucketOpenListFactory, OpenListFactory>(
+            f, h_eval, false);
     return make_pair(open, f);
 }
 }
@@ -63,8 +63,9 @@ create_wastar_open_list_factory(
   Create open list factory and f_evaluator (used for displaying progress
   statistics) for A* search.
 
-  The resulting open list factory produces a tie-breaking open list
-  ordered primarily on g + h and secondarily on h.
+  The resulting open list factory produces a bucket-based open list
+  ordered primarily on g + h and secondarily on h (see
+  bucket_open_list.h).
 */
 extern std::pair<
     std::shared_ptr<TaskIndependentOpenListFactory>,
@@ -0,0 +1,268 @@
+#include "state_registry_benchmark.h"
+
+#include "../concurrent_state_registry.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+using namespace std;
+
+namespace state_registry_benchmark {
+/*
+  We measure wall-clock time here because utils::Timer measures the CPU time
+  of all threads, which does not decrease with more threads.
+*/
+using Clock = chrono::steady_clock;
+
+static double get_seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+StateRegistryBenchmark::StateRegistryBenchmark(
+    const shared_ptr<AbstractTask> &task, const vector<int> &thread_counts,
+    int num_states, int num_shards, OperatorCost cost_type, int bound,
+    double max_time, const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          task, cost_type, bound, max_time, description, verbosity),
+      thread_counts(thread_counts),
+      num_states(num_states),
+      num_shards(num_shards) {
+    if (thread_counts.empty() ||
+        *min_element(thread_counts.begin(), thread_counts.end()) < 1) {
+        cerr << "state_registry_benchmark needs a non-empty list of "
+             << "positive thread counts." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+vector<PackedStateBin> StateRegistryBenchmark::collect_successor_data() {
+    int num_bins = state_registry.get_bins_per_state();
+    vector<PackedStateBin> data;
+    data.reserve(static_cast<size_t>(num_states) * num_bins);
+    deque<StateID> queue;
+    queue.push_back(state_registry.get_initial_state().get_id());
+    vector<OperatorID> applicable_ops;
+    int num_collected = 0;
+    while (!queue.empty() && num_collected < num_states) {
+        State state = state_registry.lookup_state(queue.front());
+        queue.pop_front();
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        for (OperatorID op_id : applicable_ops) {
+            if (num_collected == num_states) {
+                break;
+            }
+            size_t old_size = state_registry.size();
+            State succ_state = state_registry.get_successor_state(
+                state, task_proxy.get_operators()[op_id]);
+            if (state_registry.size() != old_size) {
+                queue.push_back(succ_state.get_id());
+            }
+            const PackedStateBin *buffer = succ_state.get_buffer();
+            data.insert(data.end(), buffer, buffer + num_bins);
+            ++num_collected;
+        }
+    }
+    return data;
+}
+
+void StateRegistryBenchmark::benchmark_state_data_kernels(
+    const vector<PackedStateBin> &data) {
+    size_t num_bins = state_registry.get_bins_per_state();
+    int num_states = data.size() / num_bins;
+    // Compare with a copy so that equality tests have to look at all bins.
+    vector<PackedStateBin> data_copy(data);
+    vector<int_hash_set::HashType> reference_hashes(num_states);
+
+    auto report = [&](const string &name, double seconds) {
+        log << name << ": " << seconds << "s, "
+            << (seconds > 0 ? num_states / seconds : 0) << " states/s"
+            << endl;
+    };
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < num_states; ++i) {
+        utils::HashState hash_state;
+        for (size_t bin = 0; bin < num_bins; ++bin) {
+            hash_state.feed(data[i * num_bins + bin]);
+        }
+        // The lower half of the 64-bit hash is the 32-bit hash.
+        reference_hashes[i] =
+            static_cast<int_hash_set::HashType>(hash_state.get_hash64());
+    }
+    report("Hashing bin by bin", get_seconds_since(start));
+
+    StateDataKernels kernels = get_state_data_kernels(num_bins);
+    int num_mismatches = 0;
+    start = Clock::now();
+    for (int i = 0; i < num_states; ++i) {
+        if (kernels.hash(&data[i * num_bins], num_bins) !=
+            reference_hashes[i]) {
+            ++num_mismatches;
+        }
+    }
+    report("Hashing with kernel", get_seconds_since(start));
+
+    int num_equal = 0;
+    start = Clock::now();
+    for (int i = 0; i < num_states; ++i) {
+        const PackedStateBin *lhs = &data[i * num_bins];
+        num_equal += equal(lhs, lhs + num_bins, &data_copy[i * num_bins]);
+    }
+    report("Comparing with std::equal", get_seconds_since(start));
+
+    start = Clock::now();
+    for (int i = 0; i < num_states; ++i) {
+        if (kernels.equal(
+                &data[i * num_bins], &data_copy[i * num_bins], num_bins)) {
+            --num_equal;
+        }
+    }
+    report("Comparing with kernel", get_seconds_since(start));
+
+    if (num_mismatches != 0 || num_equal != 0) {
+        cerr << "State data kernels do not match the reference "
+             << "implementation." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+double StateRegistryBenchmark::benchmark_sequential_registry(
+    const vector<PackedStateBin> &data, int &num_registered) {
+    int num_bins = state_registry.get_bins_per_state();
+    StateRegistry registry(task_proxy);
+    Clock::time_point start = Clock::now();
+    for (size_t pos = 0; pos < data.size(); pos += num_bins) {
+        registry.insert_state(&data[pos]);
+    }
+    double seconds = get_seconds_since(start);
+    num_registered = registry.size();
+    return seconds;
+}
+
+double StateRegistryBenchmark::benchmark_concurrent_registry(
+    const vector<PackedStateBin> &data, int num_threads,
+    int &num_registered) {
+    int num_bins = state_registry.get_bins_per_state();
+    int num_inserts = data.size() / num_bins;
+    /*
+      We create the registry and the threads before starting the clock, so
+      only the insertions are measured.
+    */
+    ConcurrentStateRegistry registry(task_proxy, num_threads, num_shards);
+    utils::ThreadPool thread_pool(num_threads);
+    Clock::time_point start = Clock::now();
+    thread_pool.run(num_threads, [&](int task_index, int) {
+        int begin = static_cast<int64_t>(num_inserts) * task_index /
+                    num_threads;
+        int end = static_cast<int64_t>(num_inserts) * (task_index + 1) /
+                  num_threads;
+        for (int i = begin; i < end; ++i) {
+            registry.insert_state(&data[static_cast<size_t>(i) * num_bins]);
+        }
+    });
+    double seconds = get_seconds_since(start);
+    num_registered = registry.size();
+    if (log.is_at_least_verbose()) {
+        registry.print_statistics(log);
+    }
+    return seconds;
+}
+
+SearchStatus StateRegistryBenchmark::step() {
+    vector<PackedStateBin> data = collect_successor_data();
+    int num_inserts = data.size() / state_registry.get_bins_per_state();
+    log << "Collected " << num_inserts << " successor states ("
+        << state_registry.size() << " distinct) with "
+        << state_registry.get_bins_per_state() << " bins per state" << endl;
+
+    benchmark_state_data_kernels(data);
+
+    auto report = [&](const string &name, double seconds) {
+        log << name << ": " << seconds << "s, "
+            << (seconds > 0 ? num_inserts / seconds : 0) << " inserts/s"
+            << endl;
+    };
+
+    int expected_num_registered;
+    double sequential_time =
+        benchmark_sequential_registry(data, expected_num_registered);
+    report("StateRegistry", sequential_time);
+
+    for (int num_threads : thread_counts) {
+        int num_registered;
+        double seconds =
+            benchmark_concurrent_registry(data, num_threads, num_registered);
+        report(
+            "ConcurrentStateRegistry with " + to_string(num_threads) +
+                " thread(s)",
+            seconds);
+        if (num_registered != expected_num_registered) {
+            cerr << "ConcurrentStateRegistry registered " << num_registered
+                 << " states, but StateRegistry registered "
+                 << expected_num_registered << " states." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+    return FAILED;
+}
+
+void StateRegistryBenchmark::print_statistics() const {
+    statistics.print_detailed_statistics();
+    state_registry.print_statistics(log);
+}
+
+class StateRegistryBenchmarkFeature
+    : public plugins::TypedFeature<TaskIndependentSearchAlgorithm> {
+public:
+    StateRegistryBenchmarkFeature()
+        : TypedFeature("state_registry_benchmark") {
+        document_title("State registry benchmark");
+        document_synopsis(
+            "Measures the throughput of inserting states into a "
+            "StateRegistry and into a ConcurrentStateRegistry with different "
+            "numbers of threads. This is a tool for developers and does not "
+            "search for a plan.");
+
+        add_list_option<int>(
+            "threads",
+            "numbers of threads for which the concurrent registry is "
+            "benchmarked",
+            "[1, 2, 4, 8]");
+        add_option<int>(
+            "num_states",
+            "number of generated successor states (including duplicates) "
+            "that are inserted",
+            "1000000", plugins::Bounds("1", "infinity"));
+        add_option<int>(
+            "shards", "number of hash set shards of the concurrent registry",
+            "1024", plugins::Bounds("1", "infinity"));
+        add_search_algorithm_options_to_feature(
+            *this, "state_registry_benchmark");
+
+        document_note(
+            "Timing",
+            "Throughput is measured in wall-clock time, not in CPU time like "
+            "the other timers of the planner. The options max_time and bound "
+            "are ignored.");
+    }
+
+    virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
+        const plugins::Options &opts) const override {
+        return components::make_auto_task_independent_component<
+            StateRegistryBenchmark, SearchAlgorithm>(
+            opts.get_list<int>("threads"), opts.get<int>("num_states"),
+            opts.get<int>("shards"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<StateRegistryBenchmarkFeature> _plugin;
+}
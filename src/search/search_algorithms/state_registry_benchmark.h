@@ -0,0 +1,48 @@
+#ifndef SEARCH_ALGORITHMS_STATE_REGISTRY_BENCHMARK_H
+#define SEARCH_ALGORITHMS_STATE_REGISTRY_BENCHMARK_H
+
+#include "../search_algorithm.h"
+
+#include <vector>
+
+namespace state_registry_benchmark {
+/*
+  Measure how many states per second the state registries can insert.
+
+  We first generate successor states in breadth-first order until we have
+  collected the packed data of the requested number of successors
+  (including duplicates, as in a real search). We then measure how fast the
+  state data kernels (see StateDataKernels) hash and compare these states,
+  compared to hashing them bin by bin. Finally, we insert all of these
+  states into a new StateRegistry and into a new ConcurrentStateRegistry for
+  each given number of threads and report the throughput. No plan is
+  searched, so the "search" always fails.
+*/
+class StateRegistryBenchmark : public SearchAlgorithm {
+    const std::vector<int> thread_counts;
+    const int num_states;
+    const int num_shards;
+
+    std::vector<PackedStateBin> collect_successor_data();
+    void benchmark_state_data_kernels(const std::vector<PackedStateBin> &data);
+    double benchmark_sequential_registry(
+        const std::vector<PackedStateBin> &data, int &num_registered);
+    double benchmark_concurrent_registry(
+        const std::vector<PackedStateBin> &data, int num_threads,
+        int &num_registered);
+
+protected:
+    virtual SearchStatus step() override;
+
+public:
+    StateRegistryBenchmark(
+        const std::shared_ptr<AbstractTask> &task,
+        const std::vector<int> &thread_counts, int num_states, int num_shards,
+        OperatorCost cost_type, int bound, double max_time,
+        const std::string &description, utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
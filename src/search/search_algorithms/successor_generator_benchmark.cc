@@ -0,0 +1,158 @@
+#include "successor_generator_benchmark.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../utils/logging.h"
+
+#include <chrono>
+#include <deque>
+
+using namespace std;
+
+namespace successor_generator_benchmark {
+// We measure wall-clock time to be comparable to state_registry_benchmark.
+using Clock = chrono::steady_clock;
+
+static double get_seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+SuccessorGeneratorBenchmark::SuccessorGeneratorBenchmark(
+    const shared_ptr<AbstractTask> &task, int num_states, int num_rounds,
+    OperatorCost cost_type, int bound, double max_time,
+    const string &description, utils::Verbosity verbosity)
+    : SearchAlgorithm(
+          task, cost_type, bound, max_time, description, verbosity),
+      num_states(num_states),
+      num_rounds(num_rounds) {
+}
+
+vector<vector<int>> SuccessorGeneratorBenchmark::collect_states() {
+    vector<vector<int>> states;
+    deque<StateID> queue;
+    queue.push_back(state_registry.get_initial_state().get_id());
+    vector<OperatorID> applicable_ops;
+    while (!queue.empty() && static_cast<int>(states.size()) < num_states) {
+        State state = state_registry.lookup_state(queue.front());
+        queue.pop_front();
+        state.unpack();
+        states.push_back(state.get_unpacked_values());
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        for (OperatorID op_id : applicable_ops) {
+            size_t old_size = state_registry.size();
+            State succ_state = state_registry.get_successor_state(
+                state, task_proxy.get_operators()[op_id]);
+            if (state_registry.size() != old_size) {
+                queue.push_back(succ_state.get_id());
+            }
+        }
+    }
+    return states;
+}
+
+/*
+  Return the time needed to generate the applicable operators of all states
+  num_rounds times. The operators of the last round are stored in
+  applicable_ops.
+*/
+double SuccessorGeneratorBenchmark::benchmark_generator(
+    const successor_generator::SuccessorGenerator &generator,
+    const vector<vector<int>> &states, vector<OperatorID> &applicable_ops) {
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < num_rounds; ++round) {
+        applicable_ops.clear();
+        for (const vector<int> &state : states) {
+            generator.generate_applicable_ops(state, applicable_ops);
+        }
+    }
+    return get_seconds_since(start);
+}
+
+SearchStatus SuccessorGeneratorBenchmark::step() {
+    vector<vector<int>> states = collect_states();
+    log << "Collected " << states.size() << " states" << endl;
+
+    vector<pair<string, successor_generator::SuccessorGeneratorType>> types =
+        {{"tree", successor_generator::SuccessorGeneratorType::TREE},
+         {"flat", successor_generator::SuccessorGeneratorType::FLAT}};
+    vector<OperatorID> expected_ops;
+    for (size_t i = 0; i < types.size(); ++i) {
+        const string &name = types[i].first;
+        Clock::time_point start = Clock::now();
+        successor_generator::SuccessorGenerator generator(
+            task_proxy, types[i].second);
+        log << "Time for building the " << name
+            << " successor generator: " << get_seconds_since(start) << "s"
+            << endl;
+
+        vector<OperatorID> applicable_ops;
+        double seconds = benchmark_generator(generator, states, applicable_ops);
+        double num_calls = static_cast<double>(num_rounds) * states.size();
+        double num_ops = static_cast<double>(num_rounds) *
+                         applicable_ops.size();
+        log << "Successor generator " << name << ": " << seconds << "s, "
+            << (seconds > 0 ? num_calls / seconds : 0) << " states/s, "
+            << (seconds > 0 ? num_ops / seconds : 0) << " ops/s" << endl;
+
+        if (i == 0) {
+            expected_ops = move(applicable_ops);
+        } else if (applicable_ops != expected_ops) {
+            cerr << "Successor generator " << name << " does not generate "
+                 << "the same operators as successor generator "
+                 << types[0].first << "." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+    log << "Generated " << expected_ops.size()
+        << " applicable operators per round" << endl;
+    return FAILED;
+}
+
+void SuccessorGeneratorBenchmark::print_statistics() const {
+    statistics.print_detailed_statistics();
+    state_registry.print_statistics(log);
+}
+
+class SuccessorGeneratorBenchmarkFeature
+    : public plugins::TypedFeature<TaskIndependentSearchAlgorithm> {
+public:
+    SuccessorGeneratorBenchmarkFeature()
+        : TypedFeature("successor_generator_benchmark") {
+        document_title("Successor generator benchmark");
+        document_synopsis(
+            "Measures how many applicable operators per second the different "
+            "successor generator representations compute. This is a tool "
+            "for developers and does not search for a plan.");
+
+        add_option<int>(
+            "num_states",
+            "number of distinct states whose applicable operators are "
+            "computed",
+            "100000", plugins::Bounds("1", "infinity"));
+        add_option<int>(
+            "rounds",
+            "number of times the applicable operators of all states are "
+            "computed with each representation",
+            "10", plugins::Bounds("1", "infinity"));
+        add_search_algorithm_options_to_feature(
+            *this, "successor_generator_benchmark");
+
+        document_note(
+            "Timing",
+            "Throughput is measured in wall-clock time, not in CPU time like "
+            "the other timers of the planner. The options max_time and bound "
+            "are ignored.");
+    }
+
+    virtual shared_ptr<TaskIndependentSearchAlgorithm> create_component(
+        const plugins::Options &opts) const override {
+        return components::make_auto_task_independent_component<
+            SuccessorGeneratorBenchmark, SearchAlgorithm>(
+            opts.get<int>("num_states"), opts.get<int>("rounds"),
+            get_search_algorithm_arguments_from_options(opts));
+    }
+};
+
+static plugins::FeaturePlugin<SuccessorGeneratorBenchmarkFeature> _plugin;
+}
@@ -0,0 +1,43 @@
+#ifndef SEARCH_ALGORITHMS_SUCCESSOR_GENERATOR_BENCHMARK_H
+#define SEARCH_ALGORITHMS_SUCCESSOR_GENERATOR_BENCHMARK_H
+
+#include "../search_algorithm.h"
+
+#include <vector>
+
+namespace successor_generator_benchmark {
+/*
+  Measure how fast the successor generator representations (see
+  SuccessorGeneratorType) compute the applicable operators of states.
+
+  We first collect the requested number of distinct states in breadth-first
+  order and unpack them. We then compute the applicable operators of all of
+  these states with each representation for the given number of rounds,
+  report the throughput and check that all representations generate the
+  same operators in the same order. No plan is searched, so the "search"
+  always fails.
+*/
+class SuccessorGeneratorBenchmark : public SearchAlgorithm {
+    const int num_states;
+    const int num_rounds;
+
+    std::vector<std::vector<int>> collect_states();
+    double benchmark_generator(
+        const successor_generator::SuccessorGenerator &generator,
+        const std::vector<std::vector<int>> &states,
+        std::vector<OperatorID> &applicable_ops);
+
+protected:
+    virtual SearchStatus step() override;
+
+public:
+    SuccessorGeneratorBenchmark(
+        const std::shared_ptr<AbstractTask> &task, int num_states,
+        int num_rounds, OperatorCost cost_type, int bound, double max_time,
+        const std::string &description, utils::Verbosity verbosity);
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
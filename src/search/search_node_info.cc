@@ -1,10 +1,44 @@
 #include "search_node_info.h"
 
-static const int pointer_bytes = sizeof(void *);
-static const int info_bytes = 3 * sizeof(int) + sizeof(StateID);
-static const int padding_bytes = info_bytes % pointer_bytes;
-
-static_assert(
-    sizeof(SearchNodeInfo) == info_bytes + padding_bytes,
-    "The size of SearchNodeInfo is larger than expected. This probably means "
-    "that packing two fields into one integer using bitfields is not supported.");
+#include "utils/system.h"
+
+#include <iostream>
+
+using namespace std;
+
+SearchNodeInfo::SearchNodeInfo(bool store_real_g, bool store_parents)
+    : g_index(-1),
+      real_g_index(-1),
+      parent_state_id_index(-1),
+      creating_operator_index(-1),
+      num_fields(1) {
+    if (store_parents) {
+        g_index = num_fields;
+        num_fields += 1;
+    }
+    if (store_real_g) {
+        real_g_index = num_fields;
+        num_fields += 1;
+    }
+    if (store_parents) {
+        parent_state_id_index = num_fields;
+        num_fields += NUM_STATE_ID_FIELDS;
+        creating_operator_index = num_fields;
+        num_fields += 1;
+    }
+}
+
+void SearchNodeInfo::exit_with_g_overflow(int g) {
+    cerr << "g value " << g << " does not fit into the search node "
+         << "information without parent pointers (maximum: " << MAX_PACKED_G
+         << "). Use store_parents=true." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+vector<int> SearchNodeInfo::get_default_info() const {
+    vector<int> info(num_fields, -1);
+    info[0] = 0;
+    set_status(ArrayView<int>(info.data(), num_fields), NEW);
+    set_g(ArrayView<int>(info.data(), num_fields), -1);
+    return info;
+}
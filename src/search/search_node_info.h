@@ -2,12 +2,40 @@
 #define SEARCH_NODE_INFO_H
 
 #include "operator_id.h"
+#include "per_state_array.h"
 #include "state_id.h"
 
+#include "utils/language.h"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
-struct SearchNodeInfo {
+/*
+  The information of a search node is stored as an array of ints, whose
+  layout is chosen by the SearchSpace at construction time:
+
+  - The status and the g value of the node are always stored. Without
+    parent pointers, they are packed into a single int (2 bits for the
+    status, 30 bits for g) and we abort the search if a g value does not
+    fit. With parent pointers, which need much more memory anyway, g is
+    stored as a full int.
+  - The real g value (the g value with respect to unadjusted operator
+    costs) is only stored if it can differ from the g value, i.e., if the
+    search uses adjusted operator costs.
+  - The parent state ID and the creating operator are only stored if plans
+    are traced back along parent pointers. Without them, the search space
+    reconstructs plans by regression from the goal state.
+
+  This way, nodes only use memory for the fields a search actually needs.
+  With all fields, a node uses 20 bytes (24 with 64-bit state IDs); for
+  searches with unadjusted costs and without parent pointers, it uses 4.
+*/
+class SearchNodeInfo {
+public:
     enum NodeStatus {
         NEW = 0,
         OPEN = 1,
@@ -15,18 +43,110 @@ struct SearchNodeInfo {
         DEAD_END = 3
     };
 
-    unsigned int status : 2;
-    int g : 30;
-    StateID parent_state_id;
-    OperatorID creating_operator;
-    int real_g;
-
-    SearchNodeInfo()
-        : status(NEW),
-          g(-1),
-          parent_state_id(StateID::no_state),
-          creating_operator(-1),
-          real_g(-1) {
+private:
+    static const int STATUS_BITS = 2;
+    static const int STATUS_MASK = (1 << STATUS_BITS) - 1;
+    // Range of g values that fit into the packed field (-1 means unset).
+    static const int MIN_PACKED_G = -1;
+    static const int MAX_PACKED_G = (1 << (31 - STATUS_BITS)) - 1;
+    static const int NUM_STATE_ID_FIELDS =
+        sizeof(StateID::ValueType) / sizeof(int);
+    static_assert(
+        sizeof(StateID::ValueType) % sizeof(int) == 0,
+        "StateID values cannot be stored in ints");
+
+    // Index of the g value, or -1 if it is packed with the status.
+    int g_index;
+    // Indices of the optional fields, or -1 if the field is not stored.
+    int real_g_index;
+    int parent_state_id_index;
+    int creating_operator_index;
+    int num_fields;
+
+    NO_RETURN static void exit_with_g_overflow(int g);
+
+public:
+    SearchNodeInfo(bool store_real_g, bool store_parents);
+
+    bool stores_real_g() const {
+        return real_g_index != -1;
+    }
+
+    bool stores_parents() const {
+        return parent_state_id_index != -1;
+    }
+
+    bool packs_g() const {
+        return g_index == -1;
+    }
+
+    int get_num_fields() const {
+        return num_fields;
+    }
+
+    int get_bytes_per_node() const {
+        return num_fields * sizeof(int);
+    }
+
+    // Return the information of a new node (status NEW, all values -1).
+    std::vector<int> get_default_info() const;
+
+    NodeStatus get_status(ConstArrayView<int> info) const {
+        return static_cast<NodeStatus>(info[0] & STATUS_MASK);
+    }
+
+    void set_status(ArrayView<int> info, NodeStatus status) const {
+        info[0] = (info[0] & ~STATUS_MASK) | status;
+    }
+
+    int get_g(ConstArrayView<int> info) const {
+        return packs_g() ? info[0] >> STATUS_BITS : info[g_index];
+    }
+
+    void set_g(ArrayView<int> info, int g) const {
+        if (packs_g()) {
+            if (g < MIN_PACKED_G || g > MAX_PACKED_G) {
+                exit_with_g_overflow(g);
+            }
+            info[0] = (g << STATUS_BITS) | (info[0] & STATUS_MASK);
+        } else {
+            info[g_index] = g;
+        }
+    }
+
+    int get_real_g(ConstArrayView<int> info) const {
+        return stores_real_g() ? info[real_g_index] : get_g(info);
+    }
+
+    void set_real_g(ArrayView<int> info, int real_g) const {
+        if (stores_real_g()) {
+            info[real_g_index] = real_g;
+        } else {
+            assert(real_g == get_g(info));
+        }
+    }
+
+    StateID get_parent_state_id(ConstArrayView<int> info) const {
+        assert(stores_parents());
+        StateID::ValueType value;
+        std::memcpy(&value, &info[parent_state_id_index], sizeof(value));
+        return StateID(value);
+    }
+
+    OperatorID get_creating_operator(ConstArrayView<int> info) const {
+        assert(stores_parents());
+        return OperatorID(info[creating_operator_index]);
+    }
+
+    void set_parent(
+        ArrayView<int> info, StateID parent_state_id,
+        OperatorID creating_operator) const {
+        if (stores_parents()) {
+            std::memcpy(
+                &info[parent_state_id_index], &parent_state_id.value,
+                sizeof(parent_state_id.value));
+            info[creating_operator_index] = creating_operator.get_index();
+        }
     }
 };
 
@@ -1,17 +1,30 @@
 #include "search_space.h"
 
+#include "axioms.h"
 #include "search_node_info.h"
 #include "task_proxy.h"
 
 #include "task_utils/task_properties.h"
+#include "utils/hash.h"
 #include "utils/logging.h"
+#include "utils/system.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iostream>
 
 using namespace std;
 
-SearchNode::SearchNode(const State &state, SearchNodeInfo &info)
-    : state(state), info(info) {
+/*
+  Maximum number of candidate parents that we enumerate for an operator
+  when reconstructing plans by regression.
+*/
+static const int64_t MAX_REGRESSION_CANDIDATES = 1 << 16;
+
+SearchNode::SearchNode(
+    const State &state, const SearchNodeInfo &layout, ArrayView<int> info)
+    : state(state), layout(layout), info(info) {
     assert(state.get_id() != StateID::no_state);
 }
 
@@ -20,123 +33,353 @@ const State &SearchNode::get_state() const {
 }
 
 bool SearchNode::is_open() const {
-    return info.status == SearchNodeInfo::OPEN;
+    return layout.get_status(info) == SearchNodeInfo::OPEN;
 }
 
 bool SearchNode::is_closed() const {
-    return info.status == SearchNodeInfo::CLOSED;
+    return layout.get_status(info) == SearchNodeInfo::CLOSED;
 }
 
 bool SearchNode::is_dead_end() const {
-    return info.status == SearchNodeInfo::DEAD_END;
+    return layout.get_status(info) == SearchNodeInfo::DEAD_END;
 }
 
 bool SearchNode::is_new() const {
-    return info.status == SearchNodeInfo::NEW;
+    return layout.get_status(info) == SearchNodeInfo::NEW;
 }
 
 int SearchNode::get_g() const {
-    assert(info.g >= 0);
-    return info.g;
+    assert(layout.get_g(info) >= 0);
+    return layout.get_g(info);
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return layout.get_real_g(info);
 }
 
 void SearchNode::open_initial() {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    assert(layout.get_status(info) == SearchNodeInfo::NEW);
+    layout.set_status(info, SearchNodeInfo::OPEN);
+    layout.set_g(info, 0);
+    layout.set_real_g(info, 0);
+    layout.set_parent(info, StateID::no_state, OperatorID::no_operator);
 }
 
 void SearchNode::update_parent(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    layout.set_g(info, parent_node.get_g() + adjusted_cost);
+    layout.set_real_g(info, parent_node.get_real_g() + parent_op.get_cost());
+    layout.set_parent(
+        info, parent_node.get_state().get_id(), OperatorID(parent_op.get_id()));
 }
 
 void SearchNode::open_new_node(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
+    assert(layout.get_status(info) == SearchNodeInfo::NEW);
+    layout.set_status(info, SearchNodeInfo::OPEN);
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen_closed_node(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::CLOSED);
-    info.status = SearchNodeInfo::OPEN;
+    assert(layout.get_status(info) == SearchNodeInfo::CLOSED);
+    layout.set_status(info, SearchNodeInfo::OPEN);
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::update_open_node_parent(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::OPEN);
+    assert(layout.get_status(info) == SearchNodeInfo::OPEN);
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::update_closed_node_parent(
     const SearchNode &parent_node, const OperatorProxy &parent_op,
     int adjusted_cost) {
-    assert(info.status == SearchNodeInfo::CLOSED);
+    assert(layout.get_status(info) == SearchNodeInfo::CLOSED);
     update_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close() {
-    assert(info.status == SearchNodeInfo::OPEN);
-    info.status = SearchNodeInfo::CLOSED;
+    assert(layout.get_status(info) == SearchNodeInfo::OPEN);
+    layout.set_status(info, SearchNodeInfo::CLOSED);
 }
 
 void SearchNode::mark_as_dead_end() {
-    info.status = SearchNodeInfo::DEAD_END;
+    layout.set_status(info, SearchNodeInfo::DEAD_END);
 }
 
 void SearchNode::dump(const TaskProxy &task_proxy, utils::LogProxy &log) const {
     if (log.is_at_least_debug()) {
         log << state.get_id() << ": ";
         task_properties::dump_fdr(state);
-        if (info.creating_operator != OperatorID::no_operator) {
+        if (!layout.stores_parents()) {
+            log << " parent not stored" << endl;
+        } else if (
+            layout.get_creating_operator(info) != OperatorID::no_operator) {
             OperatorsProxy operators = task_proxy.get_operators();
-            OperatorProxy op = operators[info.creating_operator.get_index()];
+            OperatorProxy op =
+                operators[layout.get_creating_operator(info).get_index()];
             log << " created by " << op.get_name() << " from "
-                << info.parent_state_id << endl;
+                << layout.get_parent_state_id(info) << endl;
         } else {
             log << " no parent" << endl;
         }
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
-    : state_registry(state_registry), log(log) {
+static bool adjusts_operator_costs(
+    const TaskProxy &task_proxy, OperatorCost cost_type, bool is_unit_cost) {
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (get_adjusted_action_cost(op, cost_type, is_unit_cost) !=
+            op.get_cost()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SearchSpace::SearchSpace(
+    StateRegistry &state_registry, OperatorCost cost_type, bool store_parents,
+    utils::LogProxy &log)
+    : state_registry(state_registry),
+      cost_type(cost_type),
+      is_unit_cost(
+          task_properties::is_unit_cost(state_registry.get_task_proxy())),
+      layout(
+          adjusts_operator_costs(
+              state_registry.get_task_proxy(), cost_type, is_unit_cost),
+          store_parents),
+      search_node_infos(layout.get_default_info()),
+      log(log) {
+}
+
+int SearchSpace::get_adjusted_cost(const OperatorProxy &op) const {
+    return get_adjusted_action_cost(op, cost_type, is_unit_cost);
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
-    return SearchNode(state, search_node_infos[state]);
+    return SearchNode(state, layout, search_node_infos[state]);
+}
+
+/*
+  Return all pairs (op, parent) such that applying op in the reached state
+  parent leads to state and g(parent) + cost(op) <= g(state).
+
+  We regress state through each operator: variables that the operator does
+  not affect have the same value in the parent, and affected variables have
+  the value required by the precondition or, if there is no such
+  precondition, any value of their domain. Derived variables are recomputed
+  with the axioms. We only keep candidates that are registered and from
+  which the operator actually leads to state. The last check also takes
+  care of conditional effects, whose effect variables we treat like
+  variables without a precondition.
+
+  Each candidate is looked up in the hash set of the state registry, so the
+  work does not depend on the size of the search space. However, the number
+  of candidates is exponential in the number of free variables. We skip
+  operators with more than MAX_REGRESSION_CANDIDATES candidates and count
+  them in num_skipped_operators.
+*/
+vector<pair<OperatorID, StateID>> SearchSpace::compute_regression_parents(
+    const State &state, int &num_skipped_operators) const {
+    const TaskProxy &task_proxy = state_registry.get_task_proxy();
+    VariablesProxy variables = task_proxy.get_variables();
+    AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[task_proxy];
+    const int_packer::IntPacker &state_packer =
+        state_registry.get_state_packer();
+    int num_bins = state_registry.get_bins_per_state();
+    int g = layout.get_g(search_node_infos[state]);
+
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+    vector<PackedStateBin> parent_buffer(num_bins);
+    vector<PackedStateBin> successor_buffer(num_bins);
+    vector<pair<OperatorID, StateID>> parents;
+
+    auto add_if_parent = [&](OperatorProxy op, int cost, StateID parent_id) {
+        State parent = state_registry.lookup_state(parent_id);
+        ConstArrayView<int> parent_info = search_node_infos[parent];
+        SearchNodeInfo::NodeStatus status = layout.get_status(parent_info);
+        if ((status == SearchNodeInfo::OPEN ||
+             status == SearchNodeInfo::CLOSED) &&
+            layout.get_g(parent_info) + cost <= g &&
+            task_properties::is_applicable(op, parent)) {
+            state_registry.compute_successor_data(
+                parent, op, successor_buffer.data());
+            if (equal(
+                    successor_buffer.begin(), successor_buffer.end(),
+                    state.get_buffer())) {
+                parents.emplace_back(OperatorID(op.get_id()), parent_id);
+            }
+        }
+    };
+
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        int cost = get_adjusted_cost(op);
+        if (cost > g) {
+            continue;
+        }
+
+        vector<int> parent_values = values;
+        vector<int> free_vars;
+        bool regressable = true;
+        for (EffectProxy effect : op.get_effects()) {
+            FactPair fact = effect.get_fact().get_pair();
+            if (effect.get_conditions().empty() &&
+                values[fact.var] != fact.value) {
+                regressable = false;
+                break;
+            }
+            free_vars.push_back(fact.var);
+        }
+        if (!regressable) {
+            continue;
+        }
+        sort(free_vars.begin(), free_vars.end());
+        free_vars.erase(
+            unique(free_vars.begin(), free_vars.end()), free_vars.end());
+        for (FactProxy precondition : op.get_preconditions()) {
+            FactPair fact = precondition.get_pair();
+            auto it = lower_bound(free_vars.begin(), free_vars.end(), fact.var);
+            if (it != free_vars.end() && *it == fact.var) {
+                parent_values[fact.var] = fact.value;
+                free_vars.erase(it);
+            } else if (!variables[fact.var].is_derived() &&
+                       values[fact.var] != fact.value) {
+                regressable = false;
+                break;
+            }
+        }
+        if (!regressable) {
+            continue;
+        }
+
+        int64_t num_candidates = 1;
+        for (int var : free_vars) {
+            num_candidates *= variables[var].get_domain_size();
+            if (num_candidates > MAX_REGRESSION_CANDIDATES) {
+                break;
+            }
+        }
+        if (num_candidates > MAX_REGRESSION_CANDIDATES) {
+            ++num_skipped_operators;
+            continue;
+        }
+
+        // Enumerate all values of the free variables.
+        for (int var : free_vars) {
+            parent_values[var] = 0;
+        }
+        for (;;) {
+            vector<int> candidate_values = parent_values;
+            axiom_evaluator.evaluate(candidate_values);
+            fill(parent_buffer.begin(), parent_buffer.end(), 0);
+            for (size_t var = 0; var < candidate_values.size(); ++var) {
+                state_packer.set(
+                    parent_buffer.data(), var, candidate_values[var]);
+            }
+            StateID parent_id =
+                state_registry.find_state_id(parent_buffer.data());
+            if (parent_id != StateID::no_state) {
+                add_if_parent(op, cost, parent_id);
+            }
+
+            // Advance to the next assignment of the free variables.
+            size_t i = 0;
+            while (i < free_vars.size()) {
+                int var = free_vars[i];
+                if (++parent_values[var] < variables[var].get_domain_size()) {
+                    break;
+                }
+                parent_values[var] = 0;
+                ++i;
+            }
+            if (i == free_vars.size()) {
+                break;
+            }
+        }
+    }
+    return parents;
+}
+
+/*
+  When a node is reached, its parent is a reached node with g(parent) +
+  cost(op) = g(node). Since g values never increase, this parent still
+  satisfies g(parent) + cost(op) <= g(node) at the end of the search. Hence,
+  a depth-first search from the goal state over such parents (see
+  compute_regression_parents) reaches the initial state, and the costs along
+  the path add up to at most the g value of the goal state. With zero-cost
+  operators, parents can form cycles, so we never visit a state twice.
+*/
+void SearchSpace::trace_path_by_regression(
+    const State &goal_state, vector<OperatorID> &path) const {
+    struct Frame {
+        State state;
+        vector<pair<OperatorID, StateID>> parents;
+        size_t next_parent;
+    };
+
+    StateID initial_state_id = state_registry.get_initial_state().get_id();
+    int num_skipped_operators = 0;
+    utils::HashSet<StateID> visited;
+    visited.insert(goal_state.get_id());
+    vector<Frame> stack;
+    stack.push_back({goal_state, {}, 0});
+    while (stack.back().state.get_id() != initial_state_id) {
+        Frame &frame = stack.back();
+        if (frame.next_parent == 0 && frame.parents.empty()) {
+            frame.parents = compute_regression_parents(
+                frame.state, num_skipped_operators);
+        }
+        if (frame.next_parent == frame.parents.size()) {
+            stack.pop_back();
+            if (stack.empty()) {
+                if (num_skipped_operators > 0) {
+                    cerr << "Could not reconstruct the plan by regression "
+                         << "because " << num_skipped_operators
+                         << " operator(s) had too many candidate parents. "
+                         << "Use store_parents=true." << endl;
+                    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+                }
+                ABORT("could not reconstruct plan by regression");
+            }
+            continue;
+        }
+        StateID parent_id = frame.parents[frame.next_parent++].second;
+        if (visited.insert(parent_id).second) {
+            stack.push_back({state_registry.lookup_state(parent_id), {}, 0});
+        }
+    }
+
+    for (auto it = stack.rbegin() + 1; it != stack.rend(); ++it) {
+        path.push_back(it->parents[it->next_parent - 1].first);
+    }
 }
 
 void SearchSpace::trace_path(
     const State &goal_state, vector<OperatorID> &path) const {
-    State current_state = goal_state;
-    assert(current_state.get_registry() == &state_registry);
+    assert(goal_state.get_registry() == &state_registry);
     assert(path.empty());
+    if (!layout.stores_parents()) {
+        trace_path_by_regression(goal_state, path);
+        return;
+    }
+    State current_state = goal_state;
     for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        ConstArrayView<int> info = search_node_infos[current_state];
+        OperatorID creating_operator = layout.get_creating_operator(info);
+        if (creating_operator == OperatorID::no_operator) {
+            assert(layout.get_parent_state_id(info) == StateID::no_state);
             break;
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        path.push_back(creating_operator);
+        current_state =
+            state_registry.lookup_state(layout.get_parent_state_id(info));
     }
     reverse(path.begin(), path.end());
 }
@@ -147,15 +390,18 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
         /* The body duplicates SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         State state = state_registry.lookup_state(id);
-        const SearchNodeInfo &node_info = search_node_infos[state];
+        ConstArrayView<int> info = search_node_infos[state];
         log << id << ": ";
         task_properties::dump_fdr(state);
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
+        if (!layout.stores_parents()) {
+            log << "parent not stored" << endl;
+        } else if (
+            layout.get_creating_operator(info) != OperatorID::no_operator &&
+            layout.get_parent_state_id(info) != StateID::no_state) {
             OperatorProxy op =
-                operators[node_info.creating_operator.get_index()];
+                operators[layout.get_creating_operator(info).get_index()];
             log << " created by " << op.get_name() << " from "
-                << node_info.parent_state_id << endl;
+                << layout.get_parent_state_id(info) << endl;
         } else {
             log << "has no parent" << endl;
         }
@@ -164,4 +410,8 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
 
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics(log);
+    log << "Search node bytes per state: " << layout.get_bytes_per_node()
+        << " (real g " << (layout.stores_real_g() ? "stored" : "not stored")
+        << ", parents " << (layout.stores_parents() ? "stored" : "not stored")
+        << ")" << endl;
 }
@@ -2,9 +2,10 @@
 #define SEARCH_SPACE_H
 
 #include "operator_cost.h"
-#include "per_state_information.h"
+#include "per_state_array.h"
 #include "search_node_info.h"
 
+#include <utility>
 #include <vector>
 
 class OperatorProxy;
@@ -17,13 +18,15 @@ class LogProxy;
 
 class SearchNode {
     State state;
-    SearchNodeInfo &info;
+    const SearchNodeInfo &layout;
+    ArrayView<int> info;
 
     void update_parent(
         const SearchNode &parent_node, const OperatorProxy &parent_op,
         int adjusted_cost);
 public:
-    SearchNode(const State &state, SearchNodeInfo &info);
+    SearchNode(
+        const State &state, const SearchNodeInfo &layout, ArrayView<int> info);
 
     const State &get_state() const;
 
@@ -55,14 +58,41 @@ public:
 };
 
 class SearchSpace {
-    PerStateInformation<SearchNodeInfo> search_node_infos;
-
     StateRegistry &state_registry;
+    OperatorCost cost_type;
+    bool is_unit_cost;
+    const SearchNodeInfo layout;
+    /*
+      Looking up the information of a state for which no node has been
+      created yet inserts default information, so we also need non-const
+      access in const methods.
+    */
+    mutable PerStateArray<int> search_node_infos;
     utils::LogProxy &log;
+
+    int get_adjusted_cost(const OperatorProxy &op) const;
+    std::vector<std::pair<OperatorID, StateID>> compute_regression_parents(
+        const State &state, int &num_skipped_operators) const;
+    void trace_path_by_regression(
+        const State &goal_state, std::vector<OperatorID> &path) const;
 public:
-    SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
+    /*
+      The search space only stores real g values if cost_type adjusts some
+      operator costs. If store_parents is false, it does not store parent
+      pointers and trace_path() reconstructs plans by regression instead.
+    */
+    SearchSpace(
+        StateRegistry &state_registry, OperatorCost cost_type,
+        bool store_parents, utils::LogProxy &log);
 
     SearchNode get_node(const State &state);
+
+    /*
+      Trace back a path from the initial state to goal_state. Without parent
+      pointers, the path is reconstructed by regression: it then consists of
+      reached (non-dead-end) states and its cost (with respect to the
+      adjusted operator costs) is at most the g value of goal_state.
+    */
     void trace_path(
         const State &goal_state, std::vector<OperatorID> &path) const;
 
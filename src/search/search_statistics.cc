@@ -15,6 +15,7 @@ SearchStatistics::SearchStatistics(utils::LogProxy &log) : log(log) {
     evaluations = 0;
     generated_states = 0;
     dead_end_states = 0;
+    pruned_by_bound_states = 0;
     generated_ops = 0;
 
     lastjump_expanded_states = 0;
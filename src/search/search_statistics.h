@@ -24,6 +24,7 @@ class SearchStatistics {
                           // since already in close list)
     int reopened_states; // no of *closed* states which we reopened
     int dead_end_states;
+    int pruned_by_bound_states; // no states pruned with a bound evaluator
 
     int generated_ops; // no of operators that were returned as applicable
 
@@ -63,6 +64,9 @@ public:
     void inc_dead_ends(int inc = 1) {
         dead_end_states += inc;
     }
+    void inc_pruned_by_bound(int inc = 1) {
+        pruned_by_bound_states += inc;
+    }
 
     // Methods that access statistics.
     int get_expanded() const {
@@ -83,6 +87,12 @@ public:
     int get_generated_ops() const {
         return generated_ops;
     }
+    int get_dead_ends() const {
+        return dead_end_states;
+    }
+    int get_pruned_by_bound() const {
+        return pruned_by_bound_states;
+    }
 
     /*
       Call the following method with the f value of every expanded
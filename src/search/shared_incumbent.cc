@@ -0,0 +1,40 @@
+#include "shared_incumbent.h"
+
+#include "task_proxy.h"
+
+using namespace std;
+
+SharedIncumbent::SharedIncumbent(int bound)
+    : cost(bound), plan_found(false), plan_manager(nullptr) {
+}
+
+void SharedIncumbent::save_improving_plans(PlanManager &plan_manager_) {
+    lock_guard<mutex> lock(plan_mutex);
+    plan_manager = &plan_manager_;
+}
+
+bool SharedIncumbent::report_plan(
+    const Plan &new_plan, const TaskProxy &task_proxy) {
+    int new_cost = calculate_plan_cost(new_plan, task_proxy);
+    lock_guard<mutex> lock(plan_mutex);
+    if (new_cost >= cost.load(memory_order_relaxed)) {
+        return false;
+    }
+    plan = new_plan;
+    plan_found = true;
+    if (plan_manager) {
+        plan_manager->save_plan(plan, task_proxy, true);
+    }
+    cost.store(new_cost, memory_order_relaxed);
+    return true;
+}
+
+bool SharedIncumbent::has_plan() {
+    lock_guard<mutex> lock(plan_mutex);
+    return plan_found;
+}
+
+Plan SharedIncumbent::get_plan() {
+    lock_guard<mutex> lock(plan_mutex);
+    return plan;
+}
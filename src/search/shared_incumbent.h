@@ -0,0 +1,48 @@
+#ifndef SHARED_INCUMBENT_H
+#define SHARED_INCUMBENT_H
+
+#include "plan_manager.h"
+
+#include <atomic>
+#include <mutex>
+
+class TaskProxy;
+
+/*
+  Best plan found so far by search algorithms that run concurrently, e.g.,
+  the members of a parallel portfolio. Search algorithms connected to a
+  shared incumbent report every plan they find and use the cost of the best
+  plan as their bound (see SearchAlgorithm::set_concurrent_search_controls).
+
+  get_cost() only reads an atomic and can be called after every search step.
+  report_plan() may be called from any thread.
+*/
+class SharedIncumbent {
+    std::atomic<int> cost;
+
+    std::mutex plan_mutex;
+    // The following members are protected by plan_mutex.
+    Plan plan;
+    bool plan_found;
+    PlanManager *plan_manager;
+public:
+    explicit SharedIncumbent(int bound);
+
+    /*
+      Save each plan that improves the incumbent with the given plan manager
+      (numbered as in anytime search). By default, plans are only stored.
+    */
+    void save_improving_plans(PlanManager &plan_manager);
+
+    // Return true iff the plan is cheaper than all previously reported plans.
+    bool report_plan(const Plan &plan, const TaskProxy &task_proxy);
+
+    int get_cost() const {
+        return cost.load(std::memory_order_relaxed);
+    }
+
+    bool has_plan();
+    Plan get_plan();
+};
+
+#endif
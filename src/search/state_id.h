@@ -1,22 +1,40 @@
 #ifndef STATE_ID_H
 #define STATE_ID_H
 
+#include "utils/hash.h"
+
+#include <cstdint>
 #include <iostream>
 
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
 class StateID {
+public:
+    /*
+      By default, state IDs are 32-bit integers, which limits registries to
+      2^30 states (see IntHashSet). Configure with -DUSE_64BIT_STATE_IDS=ON to
+      lift this limit at the cost of more memory per state.
+    */
+#ifdef USE_64BIT_STATE_IDS
+    using ValueType = std::int64_t;
+#else
+    using ValueType = int;
+#endif
+
+private:
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
     friend class PerStateInformation;
     template<typename>
     friend class PerStateArray;
     friend class PerStateBitset;
+    friend class SearchNodeInfo;
 
-    int value;
-    explicit StateID(int value_) : value(value_) {
+    ValueType value;
+    explicit StateID(ValueType value_) : value(value_) {
     }
 
     // No implementation to prevent default construction
@@ -34,6 +52,16 @@ public:
     bool operator!=(const StateID &other) const {
         return !(*this == other);
     }
+
+    std::uint64_t hash() const {
+        return value;
+    }
 };
 
+namespace utils {
+inline void feed(HashState &hash_state, StateID id) {
+    feed(hash_state, id.hash());
+}
+}
+
 #endif
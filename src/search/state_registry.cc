@@ -1,11 +1,17 @@
 #include "state_registry.h"
 
 #include "per_state_information.h"
+#include "state_values_pool.h"
 #include "task_proxy.h"
 
 #include "task_utils/task_properties.h"
+#include "utils/language.h"
 #include "utils/logging.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
 using namespace std;
 
 StateRegistry::StateRegistry(const TaskProxy &task_proxy)
@@ -19,6 +25,96 @@ StateRegistry::StateRegistry(const TaskProxy &task_proxy)
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())) {
 }
 
+static_assert(
+    sizeof(PackedStateBin) == sizeof(uint32_t),
+    "PackedStateBin does not use 4 bytes");
+static_assert(
+    is_same_v<StateID::ValueType, int_hash_set::KeyType>,
+    "StateIDs cannot be stored in IntHashSet");
+
+static int_hash_set::HashType get_hash(utils::HashState &hash_state) {
+    /*
+      The lower 32 bits of the 64-bit hash are the 32-bit hash, so the
+      bucket order does not depend on USE_64BIT_STATE_IDS.
+    */
+    if constexpr (sizeof(int_hash_set::HashType) == sizeof(uint64_t)) {
+        return hash_state.get_hash64();
+    } else {
+        return hash_state.get_hash32();
+    }
+}
+
+static int_hash_set::HashType hash_state_data_generic(
+    const PackedStateBin *data, int num_bins) {
+    utils::HashState hash_state;
+    hash_state.feed_values(data, num_bins);
+    return get_hash(hash_state);
+}
+
+template<int NumBins>
+static int_hash_set::HashType hash_state_data_fixed(
+    const PackedStateBin *data, int num_bins) {
+    assert(num_bins == NumBins);
+    utils::unused_variable(num_bins);
+    utils::HashState hash_state;
+    hash_state.feed_values(data, NumBins);
+    return get_hash(hash_state);
+}
+
+static bool state_data_equal_generic(
+    const PackedStateBin *lhs, const PackedStateBin *rhs, int num_bins) {
+    return equal(lhs, lhs + num_bins, rhs);
+}
+
+template<int NumBins>
+static bool state_data_equal_fixed(
+    const PackedStateBin *lhs, const PackedStateBin *rhs, int num_bins) {
+    assert(num_bins == NumBins);
+    utils::unused_variable(num_bins);
+    /*
+      Combining the differences of all bins avoids a branch per bin and lets
+      the compiler use vector instructions.
+    */
+    PackedStateBin difference = 0;
+    for (int i = 0; i < NumBins; ++i) {
+        difference |= lhs[i] ^ rhs[i];
+    }
+    return difference == 0;
+}
+
+template<int NumBins>
+static StateDataKernels get_fixed_kernels() {
+    return {hash_state_data_fixed<NumBins>, state_data_equal_fixed<NumBins>};
+}
+
+StateDataKernels get_state_data_kernels(int num_bins) {
+    switch (num_bins) {
+    case 1:
+        return get_fixed_kernels<1>();
+    case 2:
+        return get_fixed_kernels<2>();
+    case 3:
+        return get_fixed_kernels<3>();
+    case 4:
+        return get_fixed_kernels<4>();
+    case 5:
+        return get_fixed_kernels<5>();
+    case 6:
+        return get_fixed_kernels<6>();
+    case 7:
+        return get_fixed_kernels<7>();
+    case 8:
+        return get_fixed_kernels<8>();
+    default:
+        return {hash_state_data_generic, state_data_equal_generic};
+    }
+}
+
+int_hash_set::HashType StateRegistry::hash_state_data(
+    const PackedStateBin *data, int num_bins) {
+    return hash_state_data_generic(data, num_bins);
+}
+
 StateID StateRegistry::insert_id_or_pop_state() {
     /*
       Attempt to insert a StateID for the last state of state_data_pool
@@ -27,13 +123,15 @@ StateID StateRegistry::insert_id_or_pop_state() {
       state data pool.
     */
     StateID id(state_data_pool.size() - 1);
-    pair<int, bool> result = registered_states.insert(id.value);
+    pair<int_hash_set::KeyType, bool> result =
+        registered_states.insert(id.value);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
         state_data_pool.pop_back();
     }
     assert(
-        registered_states.size() == static_cast<int>(state_data_pool.size()));
+        static_cast<size_t>(registered_states.size()) ==
+        state_data_pool.size());
     return StateID(result.first);
 }
 
@@ -43,7 +141,7 @@ State StateRegistry::lookup_state(StateID id) const {
 }
 
 State StateRegistry::lookup_state(
-    StateID id, vector<int> &&state_values) const {
+    StateID id, shared_ptr<vector<int>> &&state_values) const {
     const PackedStateBin *buffer = state_data_pool[id.value];
     return task_proxy.create_state(*this, id, buffer, move(state_values));
 }
@@ -66,42 +164,37 @@ const State &StateRegistry::get_initial_state() {
     return *cached_initial_state;
 }
 
+/*
+  Apply op to the data of predecessor in buffer, which must already contain
+  a copy of the packed data of predecessor. For tasks with axioms, return the
+  unpacked values of the successor, otherwise nullptr.
+*/
 // TODO it would be nice to move the actual state creation (and operator
 // application)
 //      out of the StateRegistry. This could for example be done by global
 //      functions operating on state buffers (PackedStateBin *).
-State StateRegistry::get_successor_state(
-    const State &predecessor, const OperatorProxy &op) {
+shared_ptr<vector<int>> StateRegistry::apply_operator(
+    const State &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) {
     assert(!op.is_axiom());
-    /*
-      TODO: ideally, we would not modify state_data_pool here and in
-      insert_id_or_pop_state, but only at one place, to avoid errors like
-      buffer becoming a dangling pointer. This used to be a bug before being
-      fixed in https://issues.fast-downward.org/issue1115.
-    */
-    state_data_pool.push_back(predecessor.get_buffer());
-    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
     /* Experiments for issue348 showed that for tasks with axioms it's faster
        to compute successor states using unpacked data. */
     if (task_properties::has_axioms(task_proxy)) {
         predecessor.unpack();
-        vector<int> new_values = predecessor.get_unpacked_values();
+        shared_ptr<vector<int>> new_values =
+            state_values_pool::get_unused_values(num_variables);
+        *new_values = predecessor.get_unpacked_values();
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
                 FactPair effect_pair = effect.get_fact().get_pair();
-                new_values[effect_pair.var] = effect_pair.value;
+                (*new_values)[effect_pair.var] = effect_pair.value;
             }
         }
-        axiom_evaluator.evaluate(new_values);
-        for (size_t i = 0; i < new_values.size(); ++i) {
-            state_packer.set(buffer, i, new_values[i]);
+        axiom_evaluator.evaluate(*new_values);
+        for (int var = 0; var < num_variables; ++var) {
+            state_packer.set(buffer, var, (*new_values)[var]);
         }
-        /*
-          NOTE: insert_id_or_pop_state possibly invalidates buffer, hence
-          we use lookup_state to retrieve the state using the correct buffer.
-        */
-        StateID id = insert_id_or_pop_state();
-        return lookup_state(id, move(new_values));
+        return new_values;
     } else {
         for (EffectProxy effect : op.get_effects()) {
             if (does_fire(effect, predecessor)) {
@@ -109,13 +202,61 @@ State StateRegistry::get_successor_state(
                 state_packer.set(buffer, effect_pair.var, effect_pair.value);
             }
         }
-        /*
-          NOTE: insert_id_or_pop_state possibly invalidates buffer, hence
-          we use lookup_state to retrieve the state using the correct buffer.
-        */
-        StateID id = insert_id_or_pop_state();
+        return nullptr;
+    }
+}
+
+State StateRegistry::get_successor_state(
+    const State &predecessor, const OperatorProxy &op) {
+    /*
+      TODO: ideally, we would not modify state_data_pool here and in
+      insert_id_or_pop_state, but only at one place, to avoid errors like
+      buffer becoming a dangling pointer. This used to be a bug before being
+      fixed in https://issues.fast-downward.org/issue1115.
+    */
+    state_data_pool.push_back(predecessor.get_buffer());
+    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    shared_ptr<vector<int>> new_values =
+        apply_operator(predecessor, op, buffer);
+    /*
+      NOTE: insert_id_or_pop_state possibly invalidates buffer, hence
+      we use lookup_state to retrieve the state using the correct buffer.
+    */
+    StateID id = insert_id_or_pop_state();
+    if (!new_values) {
         return lookup_state(id);
+    } else {
+        return lookup_state(id, move(new_values));
+    }
+}
+
+void StateRegistry::compute_successor_data(
+    const State &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) {
+    const PackedStateBin *predecessor_buffer = predecessor.get_buffer();
+    copy(predecessor_buffer, predecessor_buffer + get_bins_per_state(), buffer);
+    apply_operator(predecessor, op, buffer);
+}
+
+State StateRegistry::insert_state(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+StateID StateRegistry::find_state_id(const PackedStateBin *buffer) {
+    /*
+      The hash set can only look up states in the state data pool, so we
+      temporarily add the data as a candidate state.
+    */
+    state_data_pool.push_back(buffer);
+    StateID candidate(state_data_pool.size() - 1);
+    int_hash_set::KeyType key = registered_states.find(candidate.value);
+    state_data_pool.pop_back();
+    if (key == -1) {
+        return StateID::no_state;
     }
+    return StateID(key);
 }
 
 int StateRegistry::get_bins_per_state() const {
@@ -129,4 +270,16 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics(utils::LogProxy &log) const {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
+    if (size() > 0) {
+        /*
+          Data structures indexed by state ID (e.g., PerStateInformation) add
+          their own memory per state, and every stored ID (e.g., in search
+          nodes and open lists) uses the size of a StateID.
+        */
+        double num_states = size();
+        log << "Registry bytes per state: state data "
+            << get_state_size_in_bytes() << ", duplicate detection "
+            << registered_states.get_allocated_bytes() / num_states
+            << ", state ID " << sizeof(StateID) << endl;
+    }
 }
@@ -80,17 +80,19 @@
   Solution:
 
     SearchNodeInfo
-      Remaining part of a search node besides the state that needs to be stored.
+      Layout of the remaining part of a search node besides the state that
+      needs to be stored. It is stored as an array of ints per state whose
+      optional fields depend on the search.
 
     SearchNode
-      A SearchNode combines a StateID, a reference to a SearchNodeInfo and
-      OperatorCost. It is generated for easier access and not intended for long
-      term storage. The state data is only stored once an can be accessed
-      through the StateID.
+      A SearchNode combines a State, the layout and a view of the stored
+      information of its node. It is generated for easier access and not
+      intended for long term storage. The state data is only stored once an
+      can be accessed through the StateID.
 
     SearchSpace
-      The SearchSpace uses PerStateInformation<SearchNodeInfo> to map StateIDs
-  to SearchNodeInfos. The open lists only have to store StateIDs which can be
+      The SearchSpace uses a PerStateArray<int> to map StateIDs to the stored
+  node information. The open lists only have to store StateIDs which can be
       used to look up a search node in the SearchSpace on demand.
 
   ---------------
@@ -111,25 +113,46 @@ class IntPacker;
 
 using PackedStateBin = int_packer::IntPacker::Bin;
 
+/*
+  Functions to hash and compare the packed data of states with a given
+  number of bins. Duplicate detection spends most of its time in these
+  functions, so registries select versions specialized for their number of
+  bins once at construction (see get_state_data_kernels). All versions
+  compute the same hash values as StateRegistry::hash_state_data.
+*/
+struct StateDataKernels {
+    using HashFunction =
+        int_hash_set::HashType (*)(const PackedStateBin *data, int num_bins);
+    using EqualFunction = bool (*)(
+        const PackedStateBin *lhs, const PackedStateBin *rhs, int num_bins);
+
+    HashFunction hash;
+    EqualFunction equal;
+};
+
+/*
+  Return kernels for the given number of bins. For small numbers of bins,
+  the loops are unrolled at compile time.
+*/
+extern StateDataKernels get_state_data_kernels(int num_bins);
+
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
         const segmented_vector::SegmentedArrayVector<PackedStateBin>
             &state_data_pool;
         int state_size;
+        StateDataKernels::HashFunction hash_function;
         StateIDSemanticHash(
             const segmented_vector::SegmentedArrayVector<PackedStateBin>
                 &state_data_pool,
             int state_size)
-            : state_data_pool(state_data_pool), state_size(state_size) {
+            : state_data_pool(state_data_pool),
+              state_size(state_size),
+              hash_function(get_state_data_kernels(state_size).hash) {
         }
 
-        int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+        int_hash_set::HashType operator()(int_hash_set::KeyType id) const {
+            return hash_function(state_data_pool[id], state_size);
         }
     };
 
@@ -137,17 +160,20 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
         const segmented_vector::SegmentedArrayVector<PackedStateBin>
             &state_data_pool;
         int state_size;
+        StateDataKernels::EqualFunction equal_function;
         StateIDSemanticEqual(
             const segmented_vector::SegmentedArrayVector<PackedStateBin>
                 &state_data_pool,
             int state_size)
-            : state_data_pool(state_data_pool), state_size(state_size) {
+            : state_data_pool(state_data_pool),
+              state_size(state_size),
+              equal_function(get_state_data_kernels(state_size).equal) {
         }
 
-        bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
-            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+        bool operator()(
+            int_hash_set::KeyType lhs, int_hash_set::KeyType rhs) const {
+            return equal_function(
+                state_data_pool[lhs], state_data_pool[rhs], state_size);
         }
     };
 
@@ -170,7 +196,9 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     std::unique_ptr<State> cached_initial_state;
 
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
+    std::shared_ptr<std::vector<int>> apply_operator(
+        const State &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer);
 public:
     explicit StateRegistry(const TaskProxy &task_proxy);
 
@@ -198,7 +226,8 @@ public:
       moved in via state_values. It is the caller's responsibility that
       the unpacked data matches the state's data.
     */
-    State lookup_state(StateID id, std::vector<int> &&state_values) const;
+    State lookup_state(
+        StateID id, std::shared_ptr<std::vector<int>> &&state_values) const;
 
     /*
       Returns a reference to the initial state and registers it if this was not
@@ -215,6 +244,48 @@ public:
     State get_successor_state(
         const State &predecessor, const OperatorProxy &op);
 
+    /*
+      Writes the packed data of the state that results from applying op to
+      predecessor into buffer, which must have room for get_bins_per_state()
+      bins. Unlike get_successor_state, this does not register the state.
+      Together with insert_state, this allows to move states between
+      registries of the same task (or of tasks with the same variables), for
+      example when each thread of a parallel search owns a registry.
+    */
+    void compute_successor_data(
+        const State &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer);
+
+    /*
+      Returns the state with the given packed data and registers it if this
+      was not done before.
+    */
+    State insert_state(const PackedStateBin *buffer);
+
+    /*
+      Returns the ID of the registered state with the given packed data, or
+      StateID::no_state if no such state is registered. Unlike insert_state,
+      this never registers a new state.
+    */
+    StateID find_state_id(const PackedStateBin *buffer);
+
+    /*
+      Returns the hash value that is used for duplicate detection of the
+      state with the given packed data.
+    */
+    int_hash_set::HashType get_state_data_hash(
+        const PackedStateBin *buffer) const {
+        return hash_state_data(buffer, get_bins_per_state());
+    }
+
+    /*
+      Returns the hash value of packed state data with the given number of
+      bins. This is the hash function used by all registries. It is equivalent
+      to feeding all bins to a utils::HashState one by one.
+    */
+    static int_hash_set::HashType hash_state_data(
+        const PackedStateBin *data, int num_bins);
+
     /*
       Returns the number of states registered so far.
     */
@@ -222,6 +293,7 @@ public:
         return registered_states.size();
     }
 
+    int get_bins_per_state() const;
     int get_state_size_in_bytes() const;
 
     void print_statistics(utils::LogProxy &log) const;
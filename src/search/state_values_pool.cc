@@ -0,0 +1,122 @@
+#include "state_values_pool.h"
+
+#include "utils/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+using namespace std;
+
+namespace state_values_pool {
+/*
+  We only look at a few vectors before allocating a new one, so that
+  vectors that are held for a long time (e.g., by the cached initial state)
+  don't make the lookup expensive. The pool size is limited to bound the
+  memory that is kept alive by the pool.
+*/
+static const int MAX_PROBES = 8;
+static const size_t MAX_POOL_SIZE = 1024;
+
+namespace {
+/*
+  Allocation and reuse counts of one thread. Only the owning thread
+  increments them, so relaxed atomic operations suffice and don't cause
+  contention, but print_statistics() can read them from any thread.
+*/
+struct Counters {
+    atomic<int64_t> num_allocated{0};
+    atomic<int64_t> num_reused{0};
+};
+
+// Counters of all live pools and totals of the pools that were destroyed.
+struct CounterRegistry {
+    mutex registry_mutex;
+    vector<const Counters *> live_counters;
+    int64_t num_allocated_by_finished_threads = 0;
+    int64_t num_reused_by_finished_threads = 0;
+};
+
+CounterRegistry &get_counter_registry() {
+    // Never destroyed, so that pools of late-exiting threads can use it.
+    static CounterRegistry *registry = new CounterRegistry();
+    return *registry;
+}
+
+struct Pool {
+    vector<shared_ptr<vector<int>>> values;
+    size_t next_probe = 0;
+    Counters counters;
+
+    Pool() {
+        CounterRegistry &registry = get_counter_registry();
+        lock_guard<mutex> lock(registry.registry_mutex);
+        registry.live_counters.push_back(&counters);
+    }
+
+    ~Pool() {
+        CounterRegistry &registry = get_counter_registry();
+        lock_guard<mutex> lock(registry.registry_mutex);
+        registry.num_allocated_by_finished_threads +=
+            counters.num_allocated.load(memory_order_relaxed);
+        registry.num_reused_by_finished_threads +=
+            counters.num_reused.load(memory_order_relaxed);
+        registry.live_counters.erase(find(
+            registry.live_counters.begin(), registry.live_counters.end(),
+            &counters));
+    }
+};
+}
+
+static thread_local Pool pool;
+
+// Only the owning thread writes a counter, so we need no atomic addition.
+static void increment(atomic<int64_t> &counter) {
+    counter.store(
+        counter.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+shared_ptr<vector<int>> get_unused_values(int num_values) {
+    vector<shared_ptr<vector<int>>> &pooled_values = pool.values;
+    size_t num_probes = min<size_t>(MAX_PROBES, pooled_values.size());
+    for (size_t i = 0; i < num_probes; ++i) {
+        shared_ptr<vector<int>> &candidate = pooled_values[pool.next_probe];
+        pool.next_probe = (pool.next_probe + 1) % pooled_values.size();
+        if (candidate.use_count() == 1) {
+            /*
+              The last State using the vector may have been destroyed by
+              another thread. The fence synchronizes with the release of its
+              reference, so we don't overwrite values that it still reads.
+            */
+            atomic_thread_fence(memory_order_acquire);
+            candidate->resize(num_values);
+            increment(pool.counters.num_reused);
+            return candidate;
+        }
+    }
+    shared_ptr<vector<int>> values = make_shared<vector<int>>(num_values);
+    increment(pool.counters.num_allocated);
+    if (pooled_values.size() < MAX_POOL_SIZE) {
+        pooled_values.push_back(values);
+    }
+    return values;
+}
+
+void print_statistics(utils::LogProxy &log) {
+    CounterRegistry &registry = get_counter_registry();
+    int64_t num_allocated;
+    int64_t num_reused;
+    {
+        lock_guard<mutex> lock(registry.registry_mutex);
+        num_allocated = registry.num_allocated_by_finished_threads;
+        num_reused = registry.num_reused_by_finished_threads;
+        for (const Counters *counters : registry.live_counters) {
+            num_allocated += counters->num_allocated.load(memory_order_relaxed);
+            num_reused += counters->num_reused.load(memory_order_relaxed);
+        }
+    }
+    log << "Unpacked state values (whole process): " << num_allocated
+        << " vector(s) allocated, " << num_reused << " reused" << endl;
+}
+}
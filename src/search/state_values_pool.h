@@ -0,0 +1,40 @@
+#ifndef STATE_VALUES_POOL_H
+#define STATE_VALUES_POOL_H
+
+#include <memory>
+#include <vector>
+
+namespace utils {
+class LogProxy;
+}
+
+/*
+  Unpacked values of states are stored in vectors that are shared between
+  all copies of a State. To avoid allocating a new vector (and the shared
+  pointer's control block) whenever a state is unpacked or a successor is
+  generated, each thread keeps a pool of these vectors and hands out those
+  vectors again that are no longer used by any State.
+
+  Lifetime rules: a vector is reused once the pool holds the only reference
+  to it, i.e., once all States using it have been destroyed. The pool of a
+  thread is destroyed when the thread exits; vectors that are still used
+  by States at that time remain valid until the last of these States is
+  destroyed. Vectors are only handed out to the thread that owns the pool,
+  but States using them can be copied to and destroyed by other threads.
+*/
+namespace state_values_pool {
+/*
+  Return a vector with the given number of elements that is not used by
+  any State. The values of the elements are unspecified.
+*/
+extern std::shared_ptr<std::vector<int>> get_unused_values(int num_values);
+
+/*
+  Print how many vectors the pools of all threads allocated and how many
+  times they reused one. The counters are shared by all state registries,
+  so the planner prints them once at the end of the search.
+*/
+extern void print_statistics(utils::LogProxy &log);
+}
+
+#endif
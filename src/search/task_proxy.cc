@@ -27,18 +27,22 @@ State::State(
 
 State::State(
     const AbstractTask &task, const StateRegistry &registry, StateID id,
-    const PackedStateBin *buffer, vector<int> &&values)
+    const PackedStateBin *buffer, shared_ptr<vector<int>> &&values)
     : State(task, registry, id, buffer) {
-    assert(num_variables == static_cast<int>(values.size()));
-    this->values = make_shared<vector<int>>(move(values));
+    assert(num_variables == static_cast<int>(values->size()));
+    this->values = move(values);
 }
 
 State::State(const AbstractTask &task, vector<int> &&values)
+    : State(task, make_shared<vector<int>>(move(values))) {
+}
+
+State::State(const AbstractTask &task, shared_ptr<vector<int>> &&values)
     : task(&task),
       registry(nullptr),
       id(StateID::no_state),
       buffer(nullptr),
-      values(make_shared<vector<int>>(move(values))),
+      values(move(values)),
       state_packer(nullptr),
       num_variables(this->values->size()) {
     assert(num_variables == task.get_num_variables());
@@ -48,18 +52,20 @@ State State::get_unregistered_successor(const OperatorProxy &op) const {
     assert(!op.is_axiom());
     assert(task_properties::is_applicable(op, *this));
     assert(values);
-    vector<int> new_values = get_unpacked_values();
+    shared_ptr<vector<int>> new_values =
+        state_values_pool::get_unused_values(num_variables);
+    *new_values = *values;
 
     for (EffectProxy effect : op.get_effects()) {
         if (does_fire(effect, *this)) {
             FactPair effect_fact = effect.get_fact().get_pair();
-            new_values[effect_fact.var] = effect_fact.value;
+            (*new_values)[effect_fact.var] = effect_fact.value;
         }
     }
 
     if (task->get_num_axioms() > 0) {
         AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[TaskProxy(*task)];
-        axiom_evaluator.evaluate(new_values);
+        axiom_evaluator.evaluate(*new_values);
     }
     return State(*task, move(new_values));
 }
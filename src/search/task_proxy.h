@@ -4,6 +4,7 @@
 #include "abstract_task.h"
 #include "operator_id.h"
 #include "state_id.h"
+#include "state_values_pool.h"
 #include "task_id.h"
 
 #include "algorithms/int_packer.h"
@@ -14,6 +15,7 @@
 #include <cassert>
 #include <cstddef>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -596,9 +598,11 @@ public:
     // Construct a registered state with packed and unpacked data.
     State(
         const AbstractTask &task, const StateRegistry &registry, StateID id,
-        const PackedStateBin *buffer, std::vector<int> &&values);
+        const PackedStateBin *buffer,
+        std::shared_ptr<std::vector<int>> &&values);
     // Construct a state with only unpacked data.
     State(const AbstractTask &task, std::vector<int> &&values);
+    State(const AbstractTask &task, std::shared_ptr<std::vector<int>> &&values);
 
     bool operator==(const State &other) const;
     bool operator!=(const State &other) const;
@@ -701,7 +705,7 @@ public:
     // This method is meant to be called only by the state registry.
     State create_state(
         const StateRegistry &registry, StateID id, const PackedStateBin *buffer,
-        std::vector<int> &&state_values) const {
+        std::shared_ptr<std::vector<int>> &&state_values) const {
         return State(*task, registry, id, buffer, std::move(state_values));
     }
 
@@ -721,13 +725,25 @@ public:
       original and the transformed task.
     */
     State convert_ancestor_state(const State &ancestor_state) const {
+        std::vector<int> state_values;
+        convert_ancestor_state_values(ancestor_state, state_values);
+        return create_state(std::move(state_values));
+    }
+
+    /*
+      Like convert_ancestor_state(), but only compute the state values and
+      store them in the given vector. Its memory is reused, so converting
+      many states with the same vector does not allocate memory.
+    */
+    void convert_ancestor_state_values(
+        const State &ancestor_state, std::vector<int> &state_values) const {
         TaskProxy ancestor_task_proxy = ancestor_state.get_task();
-        // Create a copy of the state values for the new state.
         ancestor_state.unpack();
-        std::vector<int> state_values = ancestor_state.get_unpacked_values();
+        const std::vector<int> &ancestor_values =
+            ancestor_state.get_unpacked_values();
+        state_values.assign(ancestor_values.begin(), ancestor_values.end());
         task->convert_ancestor_state_values(
             state_values, ancestor_task_proxy.task);
-        return create_state(std::move(state_values));
     }
 
     const causal_graph::CausalGraph &get_causal_graph() const;
@@ -793,7 +809,7 @@ inline void State::unpack() const {
           structures that exploit sequentially unpacking each entry, by doing
           things bin by bin.)
         */
-        values = std::make_shared<std::vector<int>>(num_variables);
+        values = state_values_pool::get_unused_values(num_variables);
         for (int var = 0; var < num_variables; ++var) {
             (*values)[var] = state_packer->get(buffer, var);
         }
@@ -5,11 +5,19 @@
 
 #include "../abstract_task.h"
 
+#include "../plugins/plugin.h"
+#include "../utils/system.h"
+
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
+SuccessorGenerator::SuccessorGenerator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type)
     : root(SuccessorGeneratorFactory(task_proxy).create()) {
+    if (type == SuccessorGeneratorType::FLAT) {
+        flat_generator = make_unique<FlatGenerator>(*root);
+        root = nullptr;
+    }
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
@@ -17,8 +25,40 @@ SuccessorGenerator::~SuccessorGenerator() = default;
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
     state.unpack();
-    root->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+    generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+}
+
+void SuccessorGenerator::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    if (flat_generator) {
+        flat_generator->generate_applicable_ops(state, applicable_ops);
+    } else {
+        root->generate_applicable_ops(state, applicable_ops);
+    }
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+PerTaskInformation<SuccessorGenerator> g_flat_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return make_unique<SuccessorGenerator>(
+            task_proxy, SuccessorGeneratorType::FLAT);
+    });
+
+SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type) {
+    switch (type) {
+    case SuccessorGeneratorType::TREE:
+        return g_successor_generators[task_proxy];
+    case SuccessorGeneratorType::FLAT:
+        return g_flat_successor_generators[task_proxy];
+    default:
+        ABORT("Unknown successor generator type.");
+    }
+}
+
+static plugins::TypedEnumPlugin<SuccessorGeneratorType> _enum_plugin(
+    {{"tree", "interpret the decision tree of generator objects"},
+     {"flat",
+      "compile the decision tree into a flat array of ints that is "
+      "interpreted in a loop without virtual calls"}});
 }
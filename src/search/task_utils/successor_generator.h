@@ -11,13 +11,28 @@ class State;
 class TaskProxy;
 
 namespace successor_generator {
+class FlatGenerator;
 class GeneratorBase;
 
+/*
+  TREE: interpret the decision tree of generator objects.
+  FLAT: compile the decision tree into a flat array and interpret that
+  (see FlatGenerator).
+*/
+enum class SuccessorGeneratorType {
+    TREE,
+    FLAT
+};
+
 class SuccessorGenerator {
+    // Exactly one of root and flat_generator is set.
     std::unique_ptr<GeneratorBase> root;
+    std::unique_ptr<FlatGenerator> flat_generator;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy,
+        SuccessorGeneratorType type = SuccessorGeneratorType::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -27,9 +42,18 @@ public:
 
     void generate_applicable_ops(
         const State &state, std::vector<OperatorID> &applicable_ops) const;
+
+    // Same as above for an unpacked state.
+    void generate_applicable_ops(
+        const std::vector<int> &state,
+        std::vector<OperatorID> &applicable_ops) const;
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_flat_successor_generators;
+
+SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type);
 }
 
 #endif
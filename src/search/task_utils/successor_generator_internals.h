@@ -18,6 +18,12 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const = 0;
+
+    /*
+      Append the flat representation of this generator and its children
+      (see FlatGenerator) to code and return the position of its first entry.
+    */
+    virtual int append_flat_code(std::vector<int> &code) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -30,6 +36,7 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -39,6 +46,7 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
@@ -51,6 +59,7 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
@@ -64,6 +73,7 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
@@ -77,6 +87,7 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -86,6 +97,7 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -95,6 +107,37 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int> &state,
         std::vector<OperatorID> &applicable_ops) const override;
+    virtual int append_flat_code(std::vector<int> &code) const override;
+};
+
+/*
+  Successor generator tree compiled into a single vector of ints, which is
+  interpreted in a loop without virtual calls. Each node starts with a tag
+  that determines the meaning of the following entries (see FlatNodeType
+  in the .cc file).
+  Children are referred to by their position, the root is at position 0.
+  Compared to the tree of GeneratorBase objects, this avoids pointer chasing
+  and the overhead of many small allocations, which matters for tasks with
+  many operators. Both generate the operators in the same order.
+*/
+class FlatGenerator {
+    std::vector<int> code;
+
+    void generate_applicable_ops(
+        int pos, const std::vector<int> &state,
+        std::vector<OperatorID> &applicable_ops) const;
+public:
+    explicit FlatGenerator(const GeneratorBase &root);
+
+    void generate_applicable_ops(
+        const std::vector<int> &state,
+        std::vector<OperatorID> &applicable_ops) const {
+        generate_applicable_ops(0, state, applicable_ops);
+    }
+
+    int get_code_size() const {
+        return code.size();
+    }
 };
 }
 
@@ -0,0 +1,620 @@
+#include "binary_root_task.h"
+
+#include "../utils/exceptions.h"
+#include "../utils/memory_mapped_file.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+
+using namespace std;
+using utils::ExitCode;
+
+namespace tasks {
+static_assert(sizeof(int) == 4, "binary task format requires 32-bit ints");
+
+static const int BINARY_TASK_MAGIC = 0x54424446; // "FDBT"
+static const int BINARY_TASK_VERSION = 1;
+static const int BYTE_ORDER_MARK = 0x01020304;
+static const string AXIOM_NAME = "<axiom>";
+
+struct BinaryTaskHeader {
+    int magic;
+    int version;
+    int byte_order_mark;
+    int num_variables;
+    int num_operators;
+    int num_axioms;
+    int num_goals;
+    int num_facts;
+    int num_mutex_entries;
+    int num_preconditions;
+    int num_effects;
+    int num_effect_conditions;
+    int num_name_bytes;
+};
+
+class BinaryRootTask : public AbstractTask {
+    utils::MemoryMappedFile file;
+    BinaryTaskHeader header;
+
+    const int *domain_sizes;
+    const int *axiom_layers;
+    const int *default_axiom_values;
+    const int *initial_state_values;
+    const int *first_fact;
+    const int *first_mutex;
+    const int *mutex_facts;
+    const int *goal_facts;
+    const int *costs;
+    const int *first_precondition;
+    const int *preconditions;
+    const int *first_effect;
+    const int *effect_facts;
+    const int *first_effect_condition;
+    const int *effect_conditions;
+    const int *name_offsets;
+    const char *names;
+
+    static FactPair get_fact(const int *facts, int index) {
+        return FactPair(facts[2 * index], facts[2 * index + 1]);
+    }
+
+    int get_action_index(int index, bool is_axiom) const {
+        if (is_axiom) {
+            assert(index >= 0 && index < header.num_axioms);
+            return header.num_operators + index;
+        } else {
+            assert(index >= 0 && index < header.num_operators);
+            return index;
+        }
+    }
+
+    int get_fact_index(const FactPair &fact) const {
+        assert(fact.var >= 0 && fact.var < header.num_variables);
+        assert(fact.value >= 0 && fact.value < domain_sizes[fact.var]);
+        return first_fact[fact.var] + fact.value;
+    }
+
+    int get_effect_index(int op_index, int eff_index, bool is_axiom) const {
+        int action = get_action_index(op_index, is_axiom);
+        assert(eff_index >= 0 &&
+               eff_index < first_effect[action + 1] - first_effect[action]);
+        return first_effect[action] + eff_index;
+    }
+
+    string get_name(int index) const {
+        return string(
+            names + name_offsets[index],
+            name_offsets[index + 1] - name_offsets[index]);
+    }
+
+public:
+    explicit BinaryRootTask(const string &filename);
+
+    virtual int get_num_variables() const override {
+        return header.num_variables;
+    }
+
+    virtual string get_variable_name(int var) const override {
+        assert(var >= 0 && var < header.num_variables);
+        return get_name(var);
+    }
+
+    virtual int get_variable_domain_size(int var) const override {
+        assert(var >= 0 && var < header.num_variables);
+        return domain_sizes[var];
+    }
+
+    virtual int get_variable_axiom_layer(int var) const override {
+        assert(var >= 0 && var < header.num_variables);
+        return axiom_layers[var];
+    }
+
+    virtual int get_variable_default_axiom_value(int var) const override {
+        assert(var >= 0 && var < header.num_variables);
+        return default_axiom_values[var];
+    }
+
+    virtual string get_fact_name(const FactPair &fact) const override {
+        return get_name(header.num_variables + get_fact_index(fact));
+    }
+
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override {
+        return costs[get_action_index(index, is_axiom)];
+    }
+
+    virtual string get_operator_name(int index, bool is_axiom) const override {
+        if (is_axiom) {
+            return AXIOM_NAME;
+        }
+        return get_name(
+            header.num_variables + header.num_facts +
+            get_action_index(index, false));
+    }
+
+    virtual int get_num_operators() const override {
+        return header.num_operators;
+    }
+
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override {
+        int action = get_action_index(index, is_axiom);
+        return first_precondition[action + 1] - first_precondition[action];
+    }
+
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override {
+        assert(
+            fact_index >= 0 &&
+            fact_index < get_num_operator_preconditions(op_index, is_axiom));
+        int action = get_action_index(op_index, is_axiom);
+        return get_fact(preconditions, first_precondition[action] + fact_index);
+    }
+
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override {
+        int action = get_action_index(op_index, is_axiom);
+        return first_effect[action + 1] - first_effect[action];
+    }
+
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override {
+        int effect = get_effect_index(op_index, eff_index, is_axiom);
+        return first_effect_condition[effect + 1] -
+               first_effect_condition[effect];
+    }
+
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index,
+        bool is_axiom) const override {
+        int effect = get_effect_index(op_index, eff_index, is_axiom);
+        assert(
+            cond_index >= 0 &&
+            cond_index < first_effect_condition[effect + 1] -
+                             first_effect_condition[effect]);
+        return get_fact(
+            effect_conditions, first_effect_condition[effect] + cond_index);
+    }
+
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override {
+        return get_fact(
+            effect_facts, get_effect_index(op_index, eff_index, is_axiom));
+    }
+
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override {
+        if (this != ancestor_task) {
+            ABORT("Invalid operator ID conversion");
+        }
+        return index;
+    }
+
+    virtual int get_num_axioms() const override {
+        return header.num_axioms;
+    }
+
+    virtual int get_num_goals() const override {
+        return header.num_goals;
+    }
+
+    virtual FactPair get_goal_fact(int index) const override {
+        assert(index >= 0 && index < header.num_goals);
+        return get_fact(goal_facts, index);
+    }
+
+    virtual vector<int> get_initial_state_values() const override {
+        return vector<int>(
+            initial_state_values, initial_state_values + header.num_variables);
+    }
+
+    virtual void convert_ancestor_state_values(
+        vector<int> &, const AbstractTask *ancestor_task) const override {
+        if (this != ancestor_task) {
+            ABORT("Invalid state conversion");
+        }
+    }
+};
+
+/*
+  Hands out consecutive arrays of a mapped binary task file and checks that
+  they lie within the file.
+*/
+class BinaryTaskFileReader {
+    const char *pos;
+    const char *end;
+
+public:
+    explicit BinaryTaskFileReader(const utils::MemoryMappedFile &file)
+        : pos(file.get_data()), end(file.get_data() + file.get_size()) {
+    }
+
+    const char *read_bytes(int64_t num_bytes, const string &name) {
+        if (num_bytes < 0 || num_bytes > end - pos) {
+            throw utils::Exception(
+                "Binary task file is truncated (reading " + name + ").");
+        }
+        const char *result = pos;
+        pos += num_bytes;
+        return result;
+    }
+
+    const int *read_ints(int64_t num_ints, const string &name) {
+        return reinterpret_cast<const int *>(
+            read_bytes(num_ints * static_cast<int64_t>(sizeof(int)), name));
+    }
+
+    bool at_end() const {
+        return pos == end;
+    }
+};
+
+BinaryRootTask::BinaryRootTask(const string &filename) : file(filename) {
+    BinaryTaskFileReader reader(file);
+    memcpy(
+        &header, reader.read_bytes(sizeof(header), "header"), sizeof(header));
+    if (header.magic != BINARY_TASK_MAGIC) {
+        throw utils::Exception(
+            "File '" + filename + "' is not a binary task file.");
+    }
+    if (header.byte_order_mark != BYTE_ORDER_MARK) {
+        throw utils::Exception(
+            "Binary task file was written on a machine with a different "
+            "byte order.");
+    }
+    if (header.version != BINARY_TASK_VERSION) {
+        throw utils::Exception(
+            "Expected binary task file version " +
+            to_string(BINARY_TASK_VERSION) + ", got " +
+            to_string(header.version) + ".");
+    }
+
+    int64_t num_variables = header.num_variables;
+    int64_t num_facts = header.num_facts;
+    int64_t num_actions =
+        static_cast<int64_t>(header.num_operators) + header.num_axioms;
+    int64_t num_effects = header.num_effects;
+    int64_t num_names =
+        num_variables + num_facts + static_cast<int64_t>(header.num_operators);
+
+    domain_sizes = reader.read_ints(num_variables, "domain sizes");
+    axiom_layers = reader.read_ints(num_variables, "axiom layers");
+    default_axiom_values =
+        reader.read_ints(num_variables, "default axiom values");
+    initial_state_values = reader.read_ints(num_variables, "initial state");
+    first_fact = reader.read_ints(num_variables + 1, "fact indices");
+    first_mutex = reader.read_ints(num_facts + 1, "mutex indices");
+    mutex_facts =
+        reader.read_ints(2 * int64_t{header.num_mutex_entries}, "mutexes");
+    goal_facts = reader.read_ints(2 * int64_t{header.num_goals}, "goals");
+    costs = reader.read_ints(num_actions, "costs");
+    first_precondition =
+        reader.read_ints(num_actions + 1, "precondition indices");
+    preconditions = reader.read_ints(
+        2 * int64_t{header.num_preconditions}, "preconditions");
+    first_effect = reader.read_ints(num_actions + 1, "effect indices");
+    effect_facts = reader.read_ints(2 * num_effects, "effects");
+    first_effect_condition =
+        reader.read_ints(num_effects + 1, "effect condition indices");
+    effect_conditions = reader.read_ints(
+        2 * int64_t{header.num_effect_conditions}, "effect conditions");
+    name_offsets = reader.read_ints(num_names + 1, "name offsets");
+    names = reader.read_bytes(header.num_name_bytes, "names");
+    if (!reader.at_end()) {
+        throw utils::Exception("Binary task file has trailing data.");
+    }
+
+    /*
+      We do not validate the arrays themselves, but at least make sure that
+      the index arrays are consistent with the header.
+    */
+    if (first_fact[num_variables] != header.num_facts ||
+        first_mutex[num_facts] != header.num_mutex_entries ||
+        first_precondition[num_actions] != header.num_preconditions ||
+        first_effect[num_actions] != header.num_effects ||
+        first_effect_condition[num_effects] != header.num_effect_conditions ||
+        name_offsets[num_names] != header.num_name_bytes) {
+        throw utils::Exception("Binary task file is inconsistent.");
+    }
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    int fact_index = get_fact_index(fact1);
+    // Binary search in the sorted list of facts mutex with fact1.
+    int low = first_mutex[fact_index];
+    int high = first_mutex[fact_index + 1];
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        FactPair mutex_fact = get_fact(mutex_facts, mid);
+        if (mutex_fact == fact2) {
+            return true;
+        } else if (mutex_fact < fact2) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+/*
+  Collects the arrays of the binary task format in memory before writing
+  them to the file.
+*/
+class BinaryTaskWriter {
+    // We use a deque so that references to the arrays stay valid.
+    deque<vector<int>> arrays;
+    string names;
+    vector<int> name_offsets;
+
+public:
+    vector<int> &add_array() {
+        arrays.emplace_back();
+        return arrays.back();
+    }
+
+    void add_name(const string &name) {
+        name_offsets.push_back(names.size());
+        names += name;
+        if (names.size() > static_cast<size_t>(numeric_limits<int>::max())) {
+            cerr << "Names of task are too long for the binary task format."
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+
+    int get_num_name_bytes() const {
+        return names.size();
+    }
+
+    void write(const string &filename) {
+        name_offsets.push_back(names.size());
+        ofstream file(filename, ios::binary);
+        for (const vector<int> &array : arrays) {
+            file.write(
+                reinterpret_cast<const char *>(array.data()),
+                array.size() * sizeof(int));
+        }
+        file.write(
+            reinterpret_cast<const char *>(name_offsets.data()),
+            name_offsets.size() * sizeof(int));
+        file.write(names.data(), names.size());
+        if (!file) {
+            cerr << "Could not write binary task file '" << filename << "'."
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+};
+
+static void append_fact(vector<int> &array, const FactPair &fact) {
+    array.push_back(fact.var);
+    array.push_back(fact.value);
+}
+
+void write_binary_task(
+    const AbstractTask &task, const vector<vector<FactPair>> &mutexes_by_fact,
+    const string &filename) {
+    BinaryTaskWriter writer;
+    vector<int> &header = writer.add_array();
+
+    int num_variables = task.get_num_variables();
+    vector<int> &domain_sizes = writer.add_array();
+    vector<int> &axiom_layers = writer.add_array();
+    vector<int> &default_axiom_values = writer.add_array();
+    vector<int> &initial_state_values = writer.add_array();
+    vector<int> &first_fact = writer.add_array();
+    initial_state_values = task.get_initial_state_values();
+    int num_facts = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        domain_sizes.push_back(task.get_variable_domain_size(var));
+        axiom_layers.push_back(task.get_variable_axiom_layer(var));
+        default_axiom_values.push_back(
+            task.get_variable_default_axiom_value(var));
+        first_fact.push_back(num_facts);
+        num_facts += task.get_variable_domain_size(var);
+    }
+    first_fact.push_back(num_facts);
+    assert(static_cast<int>(mutexes_by_fact.size()) == num_facts);
+
+    vector<int> &first_mutex = writer.add_array();
+    vector<int> &mutex_facts = writer.add_array();
+    int num_mutex_entries = 0;
+    for (const vector<FactPair> &mutexes : mutexes_by_fact) {
+        assert(is_sorted(mutexes.begin(), mutexes.end()));
+        first_mutex.push_back(num_mutex_entries);
+        for (const FactPair &fact : mutexes) {
+            append_fact(mutex_facts, fact);
+        }
+        num_mutex_entries += mutexes.size();
+    }
+    first_mutex.push_back(num_mutex_entries);
+
+    vector<int> &goal_facts = writer.add_array();
+    int num_goals = task.get_num_goals();
+    for (int i = 0; i < num_goals; ++i) {
+        append_fact(goal_facts, task.get_goal_fact(i));
+    }
+
+    vector<int> &costs = writer.add_array();
+    vector<int> &first_precondition = writer.add_array();
+    vector<int> &preconditions = writer.add_array();
+    vector<int> &first_effect = writer.add_array();
+    vector<int> &effect_facts = writer.add_array();
+    vector<int> &first_effect_condition = writer.add_array();
+    vector<int> &effect_conditions = writer.add_array();
+    int num_preconditions = 0;
+    int num_effects = 0;
+    int num_effect_conditions = 0;
+    int num_operators = task.get_num_operators();
+    int num_axioms = task.get_num_axioms();
+    for (bool is_axiom : {false, true}) {
+        int num_actions = is_axiom ? num_axioms : num_operators;
+        for (int op = 0; op < num_actions; ++op) {
+            costs.push_back(task.get_operator_cost(op, is_axiom));
+            first_precondition.push_back(num_preconditions);
+            int num_op_preconditions =
+                task.get_num_operator_preconditions(op, is_axiom);
+            for (int i = 0; i < num_op_preconditions; ++i) {
+                append_fact(
+                    preconditions,
+                    task.get_operator_precondition(op, i, is_axiom));
+            }
+            num_preconditions += num_op_preconditions;
+            first_effect.push_back(num_effects);
+            int num_op_effects = task.get_num_operator_effects(op, is_axiom);
+            for (int eff = 0; eff < num_op_effects; ++eff) {
+                append_fact(
+                    effect_facts, task.get_operator_effect(op, eff, is_axiom));
+                first_effect_condition.push_back(num_effect_conditions);
+                int num_conditions = task.get_num_operator_effect_conditions(
+                    op, eff, is_axiom);
+                for (int i = 0; i < num_conditions; ++i) {
+                    append_fact(
+                        effect_conditions,
+                        task.get_operator_effect_condition(
+                            op, eff, i, is_axiom));
+                }
+                num_effect_conditions += num_conditions;
+            }
+            num_effects += num_op_effects;
+        }
+    }
+    first_precondition.push_back(num_preconditions);
+    first_effect.push_back(num_effects);
+    first_effect_condition.push_back(num_effect_conditions);
+
+    for (int var = 0; var < num_variables; ++var) {
+        writer.add_name(task.get_variable_name(var));
+    }
+    for (int var = 0; var < num_variables; ++var) {
+        for (int value = 0; value < domain_sizes[var]; ++value) {
+            writer.add_name(task.get_fact_name(FactPair(var, value)));
+        }
+    }
+    for (int op = 0; op < num_operators; ++op) {
+        writer.add_name(task.get_operator_name(op, false));
+    }
+
+    header = {
+        BINARY_TASK_MAGIC,     BINARY_TASK_VERSION,
+        BYTE_ORDER_MARK,       num_variables,
+        num_operators,         num_axioms,
+        num_goals,             num_facts,
+        num_mutex_entries,     num_preconditions,
+        num_effects,           num_effect_conditions,
+        writer.get_num_name_bytes()};
+    assert(header.size() * sizeof(int) == sizeof(BinaryTaskHeader));
+    writer.write(filename);
+}
+
+shared_ptr<AbstractTask> read_binary_task(const string &filename) {
+    try {
+        return make_shared<BinaryRootTask>(filename);
+    } catch (const utils::Exception &error) {
+        cerr << "Error reading binary task" << endl;
+        error.print();
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+static void check_equal(bool equal, const string &what) {
+    if (!equal) {
+        cerr << "Binary task differs from text task: " << what << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+void verify_tasks_are_equal(
+    const AbstractTask &task1, const AbstractTask &task2) {
+    int num_variables = task1.get_num_variables();
+    check_equal(num_variables == task2.get_num_variables(), "variables");
+    for (int var = 0; var < num_variables; ++var) {
+        int domain_size = task1.get_variable_domain_size(var);
+        check_equal(
+            task1.get_variable_name(var) == task2.get_variable_name(var) &&
+                domain_size == task2.get_variable_domain_size(var) &&
+                task1.get_variable_axiom_layer(var) ==
+                    task2.get_variable_axiom_layer(var) &&
+                task1.get_variable_default_axiom_value(var) ==
+                    task2.get_variable_default_axiom_value(var),
+            "variable " + to_string(var));
+        for (int value = 0; value < domain_size; ++value) {
+            FactPair fact(var, value);
+            check_equal(
+                task1.get_fact_name(fact) == task2.get_fact_name(fact),
+                "name of fact " + to_string(var) + "=" + to_string(value));
+        }
+    }
+    check_equal(
+        task1.get_initial_state_values() == task2.get_initial_state_values(),
+        "initial state");
+    int num_goals = task1.get_num_goals();
+    check_equal(num_goals == task2.get_num_goals(), "goals");
+    for (int i = 0; i < num_goals; ++i) {
+        check_equal(task1.get_goal_fact(i) == task2.get_goal_fact(i), "goals");
+    }
+    for (bool is_axiom : {false, true}) {
+        int num_actions =
+            is_axiom ? task1.get_num_axioms() : task1.get_num_operators();
+        check_equal(
+            num_actions ==
+                (is_axiom ? task2.get_num_axioms() : task2.get_num_operators()),
+            is_axiom ? "axioms" : "operators");
+        for (int op = 0; op < num_actions; ++op) {
+            string what = (is_axiom ? "axiom " : "operator ") + to_string(op);
+            int num_preconditions =
+                task1.get_num_operator_preconditions(op, is_axiom);
+            int num_effects = task1.get_num_operator_effects(op, is_axiom);
+            check_equal(
+                task1.get_operator_name(op, is_axiom) ==
+                        task2.get_operator_name(op, is_axiom) &&
+                    task1.get_operator_cost(op, is_axiom) ==
+                        task2.get_operator_cost(op, is_axiom) &&
+                    num_preconditions ==
+                        task2.get_num_operator_preconditions(op, is_axiom) &&
+                    num_effects ==
+                        task2.get_num_operator_effects(op, is_axiom),
+                what);
+            for (int i = 0; i < num_preconditions; ++i) {
+                check_equal(
+                    task1.get_operator_precondition(op, i, is_axiom) ==
+                        task2.get_operator_precondition(op, i, is_axiom),
+                    what);
+            }
+            for (int eff = 0; eff < num_effects; ++eff) {
+                int num_conditions =
+                    task1.get_num_operator_effect_conditions(op, eff, is_axiom);
+                check_equal(
+                    task1.get_operator_effect(op, eff, is_axiom) ==
+                            task2.get_operator_effect(op, eff, is_axiom) &&
+                        num_conditions ==
+                            task2.get_num_operator_effect_conditions(
+                                op, eff, is_axiom),
+                    what);
+                for (int i = 0; i < num_conditions; ++i) {
+                    check_equal(
+                        task1.get_operator_effect_condition(
+                            op, eff, i, is_axiom) ==
+                            task2.get_operator_effect_condition(
+                                op, eff, i, is_axiom),
+                        what);
+                }
+            }
+        }
+    }
+}
+}
@@ -0,0 +1,76 @@
+#ifndef TASKS_BINARY_ROOT_TASK_H
+#define TASKS_BINARY_ROOT_TASK_H
+
+#include "../abstract_task.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+  Binary task format
+
+  Reading a large task in the text format of the translator is slow and
+  needs much more memory than the task itself, because every token is
+  parsed separately and every operator is stored with its own vectors and
+  strings. The binary format stores the same information in flat arrays
+  that are used in place after mapping the file into memory (see
+  utils::MemoryMappedFile), so loading a task only has to check the header.
+  Names are stored at the end of the file and are only read when they are
+  needed, e.g., when a plan is written.
+
+  All numbers are stored as 32-bit integers in the byte order of the machine
+  that wrote the file. The file consists of the following arrays in this
+  order, where V, O, A, G, F, M, P, E, C and S are the numbers of variables,
+  operators, axioms, goals, facts, mutex entries, preconditions, effects,
+  effect conditions and bytes of names. Facts are stored as pairs of
+  variable and value, and operators and axioms are stored together with the
+  axioms after the operators (N = O + A).
+
+  - header: magic number, format version, byte order mark, V, O, A, G, F,
+    M, P, E, C, S
+  - variables: domain sizes [V], axiom layers [V], default axiom values [V],
+    initial state values with evaluated axioms [V], index of the first fact
+    of each variable [V + 1]
+  - mutexes: index of the first mutex entry of each fact [F + 1], facts
+    mutex with each fact, sorted [2M]
+  - goals: goal facts [2G]
+  - actions: costs [N], index of the first precondition [N + 1],
+    preconditions [2P], index of the first effect [N + 1], effect facts
+    [2E], index of the first condition of each effect [E + 1], effect
+    conditions [2C]
+  - names: offset of the first byte of the name of each variable, fact and
+    operator [V + F + O + 1], followed by the names [S bytes]
+
+  Files are trusted to be written by write_binary_task(): when reading them,
+  we only verify the header and the size of the file, not their contents.
+*/
+namespace tasks {
+/*
+  Write the given task to a file in the binary task format. The mutexes are
+  given as a list of the facts that are mutex with each fact, in the order
+  of the variables and their values.
+*/
+extern void write_binary_task(
+    const AbstractTask &task,
+    const std::vector<std::vector<FactPair>> &mutexes_by_fact,
+    const std::string &filename);
+
+/*
+  Read a task from a file in the binary task format. Exits with
+  SEARCH_INPUT_ERROR if the file cannot be read or is not a valid binary
+  task file.
+*/
+extern std::shared_ptr<AbstractTask> read_binary_task(
+    const std::string &filename);
+
+/*
+  Check that the two tasks are identical, except for the mutexes, which
+  cannot be enumerated through the AbstractTask interface. Exits with
+  SEARCH_CRITICAL_ERROR if they differ.
+*/
+extern void verify_tasks_are_equal(
+    const AbstractTask &task1, const AbstractTask &task2);
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "flattened_task.h"
+
+using namespace std;
+
+namespace tasks {
+FlattenedTask::OperatorTable::OperatorTable(
+    const AbstractTask &task, bool is_axiom) {
+    int num_ops = is_axiom ? task.get_num_axioms() : task.get_num_operators();
+    costs.reserve(num_ops);
+    precondition_offsets.reserve(num_ops + 1);
+    effect_offsets.reserve(num_ops + 1);
+    precondition_offsets.push_back(0);
+    effect_offsets.push_back(0);
+    effect_condition_offsets.push_back(0);
+    for (int op = 0; op < num_ops; ++op) {
+        costs.push_back(task.get_operator_cost(op, is_axiom));
+        int num_preconditions =
+            task.get_num_operator_preconditions(op, is_axiom);
+        for (int i = 0; i < num_preconditions; ++i) {
+            preconditions.push_back(
+                task.get_operator_precondition(op, i, is_axiom));
+        }
+        precondition_offsets.push_back(preconditions.size());
+        int num_effects = task.get_num_operator_effects(op, is_axiom);
+        for (int eff = 0; eff < num_effects; ++eff) {
+            effects.push_back(task.get_operator_effect(op, eff, is_axiom));
+            int num_conditions =
+                task.get_num_operator_effect_conditions(op, eff, is_axiom);
+            for (int i = 0; i < num_conditions; ++i) {
+                effect_conditions.push_back(
+                    task.get_operator_effect_condition(op, eff, i, is_axiom));
+            }
+            effect_condition_offsets.push_back(effect_conditions.size());
+        }
+        effect_offsets.push_back(effects.size());
+    }
+    preconditions.shrink_to_fit();
+    effects.shrink_to_fit();
+    effect_condition_offsets.shrink_to_fit();
+    effect_conditions.shrink_to_fit();
+}
+
+FlattenedTask::FlattenedTask(const shared_ptr<AbstractTask> &parent)
+    : DelegatingTask(parent),
+      operators(*parent, false),
+      axioms(*parent, true),
+      initial_state_values(parent->get_initial_state_values()) {
+    int num_variables = parent->get_num_variables();
+    domain_sizes.reserve(num_variables);
+    axiom_layers.reserve(num_variables);
+    default_axiom_values.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        domain_sizes.push_back(parent->get_variable_domain_size(var));
+        axiom_layers.push_back(parent->get_variable_axiom_layer(var));
+        default_axiom_values.push_back(
+            parent->get_variable_default_axiom_value(var));
+    }
+    int num_goals = parent->get_num_goals();
+    goals.reserve(num_goals);
+    for (int i = 0; i < num_goals; ++i) {
+        goals.push_back(parent->get_goal_fact(i));
+    }
+}
+}
@@ -0,0 +1,151 @@
+#ifndef TASKS_FLATTENED_TASK_H
+#define TASKS_FLATTENED_TASK_H
+
+#include "delegating_task.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace tasks {
+/*
+  Snapshot of the variables, operators, axioms, goals and initial state of
+  the parent task, which may be the result of an arbitrary chain of task
+  transformations. The data is copied into flat arrays once, so queries no
+  longer pass through the virtual methods of all tasks in the chain and
+  transformations that compute their answers on the fly (e.g., the adjusted
+  costs of a CostAdaptedTask) are evaluated only once. Names and mutexes are
+  still delegated to the parent task since they are not used in
+  performance-critical code.
+
+  The class is final, so code that uses a FlattenedTask directly instead of
+  through a TaskProxy can call its methods without virtual dispatch.
+*/
+class FlattenedTask final : public DelegatingTask {
+    struct OperatorTable {
+        std::vector<int> costs;
+        std::vector<int> precondition_offsets;
+        std::vector<FactPair> preconditions;
+        std::vector<int> effect_offsets;
+        std::vector<FactPair> effects;
+        std::vector<int> effect_condition_offsets;
+        std::vector<FactPair> effect_conditions;
+
+        OperatorTable(const AbstractTask &task, bool is_axiom);
+    };
+
+    std::vector<int> domain_sizes;
+    std::vector<int> axiom_layers;
+    std::vector<int> default_axiom_values;
+    OperatorTable operators;
+    OperatorTable axioms;
+    std::vector<FactPair> goals;
+    std::vector<int> initial_state_values;
+
+    const OperatorTable &get_table(bool is_axiom) const {
+        return is_axiom ? axioms : operators;
+    }
+
+    int get_effect_id(int op_index, int eff_index, bool is_axiom) const {
+        const OperatorTable &table = get_table(is_axiom);
+        assert(eff_index >= 0 &&
+               eff_index < table.effect_offsets[op_index + 1] -
+                               table.effect_offsets[op_index]);
+        return table.effect_offsets[op_index] + eff_index;
+    }
+public:
+    explicit FlattenedTask(const std::shared_ptr<AbstractTask> &parent);
+    virtual ~FlattenedTask() override = default;
+
+    virtual int get_num_variables() const override {
+        return domain_sizes.size();
+    }
+
+    virtual int get_variable_domain_size(int var) const override {
+        return domain_sizes[var];
+    }
+
+    virtual int get_variable_axiom_layer(int var) const override {
+        return axiom_layers[var];
+    }
+
+    virtual int get_variable_default_axiom_value(int var) const override {
+        return default_axiom_values[var];
+    }
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override {
+        return get_table(is_axiom).costs[index];
+    }
+
+    virtual int get_num_operators() const override {
+        return operators.costs.size();
+    }
+
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override {
+        const OperatorTable &table = get_table(is_axiom);
+        return table.precondition_offsets[index + 1] -
+               table.precondition_offsets[index];
+    }
+
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override {
+        const OperatorTable &table = get_table(is_axiom);
+        assert(fact_index >= 0 &&
+               fact_index < get_num_operator_preconditions(op_index, is_axiom));
+        return table.preconditions
+            [table.precondition_offsets[op_index] + fact_index];
+    }
+
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override {
+        const OperatorTable &table = get_table(is_axiom);
+        return table.effect_offsets[op_index + 1] -
+               table.effect_offsets[op_index];
+    }
+
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override {
+        const OperatorTable &table = get_table(is_axiom);
+        int eff_id = get_effect_id(op_index, eff_index, is_axiom);
+        return table.effect_condition_offsets[eff_id + 1] -
+               table.effect_condition_offsets[eff_id];
+    }
+
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index,
+        bool is_axiom) const override {
+        const OperatorTable &table = get_table(is_axiom);
+        int eff_id = get_effect_id(op_index, eff_index, is_axiom);
+        assert(cond_index >= 0 &&
+               cond_index < table.effect_condition_offsets[eff_id + 1] -
+                                table.effect_condition_offsets[eff_id]);
+        return table.effect_conditions
+            [table.effect_condition_offsets[eff_id] + cond_index];
+    }
+
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override {
+        return get_table(is_axiom)
+            .effects[get_effect_id(op_index, eff_index, is_axiom)];
+    }
+
+    virtual int get_num_axioms() const override {
+        return axioms.costs.size();
+    }
+
+    virtual int get_num_goals() const override {
+        return goals.size();
+    }
+
+    virtual FactPair get_goal_fact(int index) const override {
+        return goals[index];
+    }
+
+    virtual std::vector<int> get_initial_state_values() const override {
+        return initial_state_values;
+    }
+};
+}
+
+#endif
@@ -1,11 +1,17 @@
 #include "root_task.h"
 
+#include "binary_root_task.h"
+
 #include "../axioms.h"
 
 #include "../utils/collections.h"
+#include "../utils/logging.h"
 #include "../utils/task_lexer.h"
+#include "../utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <type_traits>
@@ -31,40 +37,277 @@ struct ExplicitEffect {
     vector<FactPair> conditions;
 };
 
+// Used while parsing an operator, which is then added to an operator table.
 struct ExplicitOperator {
     vector<FactPair> preconditions;
     vector<ExplicitEffect> effects;
     int cost;
     string name;
-    bool is_an_axiom;
 };
 
+/*
+  Stores a list of operators (or axioms) in compressed sparse row format:
+  the preconditions, effects and effect conditions of all operators are
+  kept in one array each, and offset tables store where the entries of each
+  operator (or effect) begin. Compared to storing each operator as an
+  ExplicitOperator, this avoids many small allocations, which take a lot of
+  time and memory for tasks with many operators, and keeps the data of
+  consecutive operators close together in memory.
+*/
+class ExplicitOperatorTable {
+    vector<int> costs;
+    vector<int> precondition_offsets;
+    vector<FactPair> preconditions;
+    vector<int> effect_offsets;
+    vector<FactPair> effects;
+    vector<int> effect_condition_offsets;
+    vector<FactPair> effect_conditions;
+    vector<int> name_offsets;
+    string names;
+
+    int get_effect_index(int op, int eff) const {
+        assert(utils::in_bounds(op, costs));
+        assert(eff >= 0 && eff < get_num_effects(op));
+        return effect_offsets[op] + eff;
+    }
+
+public:
+    ExplicitOperatorTable()
+        : precondition_offsets(1, 0),
+          effect_offsets(1, 0),
+          effect_condition_offsets(1, 0),
+          name_offsets(1, 0) {
+    }
+
+    void push_back(const ExplicitOperator &op);
+    void shrink_to_fit();
+
+    int size() const {
+        return costs.size();
+    }
+
+    int get_cost(int op) const {
+        assert(utils::in_bounds(op, costs));
+        return costs[op];
+    }
+
+    string get_name(int op) const {
+        assert(utils::in_bounds(op, costs));
+        return names.substr(
+            name_offsets[op], name_offsets[op + 1] - name_offsets[op]);
+    }
+
+    int get_num_preconditions(int op) const {
+        assert(utils::in_bounds(op, costs));
+        return precondition_offsets[op + 1] - precondition_offsets[op];
+    }
+
+    FactPair get_precondition(int op, int index) const {
+        assert(index >= 0 && index < get_num_preconditions(op));
+        return preconditions[precondition_offsets[op] + index];
+    }
+
+    int get_num_effects(int op) const {
+        assert(utils::in_bounds(op, costs));
+        return effect_offsets[op + 1] - effect_offsets[op];
+    }
+
+    FactPair get_effect(int op, int eff) const {
+        return effects[get_effect_index(op, eff)];
+    }
+
+    int get_num_effect_conditions(int op, int eff) const {
+        int effect = get_effect_index(op, eff);
+        return effect_condition_offsets[effect + 1] -
+               effect_condition_offsets[effect];
+    }
+
+    FactPair get_effect_condition(int op, int eff, int index) const {
+        int effect = get_effect_index(op, eff);
+        assert(index >= 0 && index < get_num_effect_conditions(op, eff));
+        return effect_conditions[effect_condition_offsets[effect] + index];
+    }
+};
+
+void ExplicitOperatorTable::push_back(const ExplicitOperator &op) {
+    costs.push_back(op.cost);
+    preconditions.insert(
+        preconditions.end(), op.preconditions.begin(), op.preconditions.end());
+    precondition_offsets.push_back(preconditions.size());
+    for (const ExplicitEffect &effect : op.effects) {
+        effects.push_back(effect.fact);
+        effect_conditions.insert(
+            effect_conditions.end(), effect.conditions.begin(),
+            effect.conditions.end());
+        effect_condition_offsets.push_back(effect_conditions.size());
+    }
+    effect_offsets.push_back(effects.size());
+    names += op.name;
+    name_offsets.push_back(names.size());
+}
+
+void ExplicitOperatorTable::shrink_to_fit() {
+    costs.shrink_to_fit();
+    precondition_offsets.shrink_to_fit();
+    preconditions.shrink_to_fit();
+    effect_offsets.shrink_to_fit();
+    effects.shrink_to_fit();
+    effect_condition_offsets.shrink_to_fit();
+    effect_conditions.shrink_to_fit();
+    name_offsets.shrink_to_fit();
+    names.shrink_to_fit();
+}
+
+/*
+  Stores which facts are mutex with each fact. Facts are numbered
+  consecutively in the order of the variables and their values. For each
+  fact, we store the numbers of its mutex facts either as a sorted array,
+  which is searched by binary search, or as a bitset over all facts, which
+  allows lookups in constant time, depending on which of the two uses less
+  memory. Most facts are mutex with only few facts, so their arrays are
+  short, while the facts with the most mutexes get bitsets.
+*/
+class MutexIndex {
+    using Block = uint64_t;
+    static const int BITS_PER_BLOCK = 64;
+
+    vector<int> first_fact;
+    int num_blocks_per_bitset;
+    vector<int> mutex_offsets;
+    vector<int> mutex_facts;
+    // Start of the bitset of each fact in bitsets, or -1 if it has none.
+    vector<int64_t> bitset_offsets;
+    vector<Block> bitsets;
+
+    int get_fact_number(const FactPair &fact) const {
+        assert(utils::in_bounds(fact.var, first_fact));
+        assert(fact.value >= 0 &&
+               first_fact[fact.var] + fact.value < first_fact[fact.var + 1]);
+        return first_fact[fact.var] + fact.value;
+    }
+
+public:
+    /*
+      domain_sizes are the domain sizes of the variables. mutexes_by_fact
+      contains the numbers of the facts that are mutex with each fact and
+      may contain duplicates.
+    */
+    MutexIndex(
+        const vector<int> &domain_sizes, vector<vector<int>> &&mutexes_by_fact);
+
+    bool are_mutex(const FactPair &fact1, const FactPair &fact2) const;
+
+    // Return the sorted list of facts that are mutex with each fact.
+    vector<vector<FactPair>> get_mutexes_by_fact() const;
+};
+
+MutexIndex::MutexIndex(
+    const vector<int> &domain_sizes, vector<vector<int>> &&mutexes_by_fact)
+    : first_fact(1, 0) {
+    for (int domain_size : domain_sizes) {
+        first_fact.push_back(first_fact.back() + domain_size);
+    }
+    int num_facts = first_fact.back();
+    assert(static_cast<int>(mutexes_by_fact.size()) == num_facts);
+    num_blocks_per_bitset = (num_facts + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+    int64_t bitset_bytes = num_blocks_per_bitset * sizeof(Block);
+
+    mutex_offsets.reserve(num_facts + 1);
+    mutex_offsets.push_back(0);
+    bitset_offsets.reserve(num_facts);
+    for (vector<int> &mutexes : mutexes_by_fact) {
+        utils::sort_unique(mutexes);
+        if (static_cast<int64_t>(mutexes.size() * sizeof(int)) >
+            bitset_bytes) {
+            int64_t offset = bitsets.size();
+            bitset_offsets.push_back(offset);
+            bitsets.resize(offset + num_blocks_per_bitset, 0);
+            for (int fact : mutexes) {
+                bitsets[offset + fact / BITS_PER_BLOCK] |=
+                    Block(1) << (fact % BITS_PER_BLOCK);
+            }
+        } else {
+            bitset_offsets.push_back(-1);
+            mutex_facts.insert(
+                mutex_facts.end(), mutexes.begin(), mutexes.end());
+        }
+        mutex_offsets.push_back(mutex_facts.size());
+        utils::release_vector_memory(mutexes);
+    }
+    mutex_facts.shrink_to_fit();
+    bitsets.shrink_to_fit();
+}
+
+bool MutexIndex::are_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    int number1 = get_fact_number(fact1);
+    int number2 = get_fact_number(fact2);
+    int64_t bitset_offset = bitset_offsets[number1];
+    if (bitset_offset != -1) {
+        Block block = bitsets[bitset_offset + number2 / BITS_PER_BLOCK];
+        return (block >> (number2 % BITS_PER_BLOCK)) & 1;
+    }
+    return binary_search(
+        mutex_facts.begin() + mutex_offsets[number1],
+        mutex_facts.begin() + mutex_offsets[number1 + 1], number2);
+}
+
+vector<vector<FactPair>> MutexIndex::get_mutexes_by_fact() const {
+    int num_variables = first_fact.size() - 1;
+    vector<FactPair> facts;
+    for (int var = 0; var < num_variables; ++var) {
+        for (int value = 0; value < first_fact[var + 1] - first_fact[var];
+             ++value) {
+            facts.emplace_back(var, value);
+        }
+    }
+    int num_facts = facts.size();
+    vector<vector<FactPair>> mutexes_by_fact(num_facts);
+    for (int number = 0; number < num_facts; ++number) {
+        int64_t bitset_offset = bitset_offsets[number];
+        if (bitset_offset != -1) {
+            for (int other = 0; other < num_facts; ++other) {
+                Block block = bitsets[bitset_offset + other / BITS_PER_BLOCK];
+                if ((block >> (other % BITS_PER_BLOCK)) & 1) {
+                    mutexes_by_fact[number].push_back(facts[other]);
+                }
+            }
+        } else {
+            for (int i = mutex_offsets[number]; i < mutex_offsets[number + 1];
+                 ++i) {
+                mutexes_by_fact[number].push_back(facts[mutex_facts[i]]);
+            }
+        }
+    }
+    return mutexes_by_fact;
+}
+
 class RootTask : public AbstractTask {
     vector<ExplicitVariable> variables;
-    // TODO: think about using hash sets here.
-    vector<vector<set<FactPair>>> mutexes;
-    vector<ExplicitOperator> operators;
-    vector<ExplicitOperator> axioms;
+    MutexIndex mutexes;
+    ExplicitOperatorTable operators;
+    ExplicitOperatorTable axioms;
     vector<int> initial_state_values;
     vector<FactPair> goals;
 
     const ExplicitVariable &get_variable(int var) const;
-    const ExplicitEffect &get_effect(
-        int op_id, int effect_id, bool is_axiom) const;
-    const ExplicitOperator &get_operator_or_axiom(
-        int index, bool is_axiom) const;
+    const ExplicitOperatorTable &get_operators_or_axioms(bool is_axiom) const {
+        return is_axiom ? axioms : operators;
+    }
 
 public:
     RootTask(
-        vector<ExplicitVariable> &&variables,
-        vector<vector<set<FactPair>>> &&mutexes,
-        vector<ExplicitOperator> &&operators, vector<ExplicitOperator> &&axioms,
+        vector<ExplicitVariable> &&variables, MutexIndex &&mutexes,
+        ExplicitOperatorTable &&operators, ExplicitOperatorTable &&axioms,
         vector<int> &&initial_state_values, vector<FactPair> &&goals);
 
     vector<int> &get_initial_state_values() {
         return initial_state_values;
     }
 
+    // Return the sorted list of facts that are mutex with each fact.
+    vector<vector<FactPair>> get_mutexes_by_fact() const;
+
     virtual int get_num_variables() const override;
     virtual string get_variable_name(int var) const override;
     virtual int get_variable_domain_size(int var) const override;
@@ -159,11 +402,11 @@ class TaskParser {
     ExplicitVariable read_variable(int index);
     vector<FactPair> read_facts(
         bool read_from_single_line, const vector<ExplicitVariable> &variables);
-    vector<vector<set<FactPair>>> read_mutexes(
+    MutexIndex read_mutexes(
         const vector<ExplicitVariable> &variables);
     vector<int> read_initial_state(const vector<ExplicitVariable> &variables);
     vector<FactPair> read_goal(const vector<ExplicitVariable> &variables);
-    vector<ExplicitOperator> read_actions(
+    ExplicitOperatorTable read_actions(
         bool is_axiom, bool use_metric,
         const vector<ExplicitVariable> &variables);
     ExplicitOperator read_operator(
@@ -433,7 +676,6 @@ void TaskParser::read_conditional_effect(
 ExplicitOperator TaskParser::read_operator(
     int index, bool use_metric, const vector<ExplicitVariable> &variables) {
     ExplicitOperator op;
-    op.is_an_axiom = false;
     with_error_context(
         [&]() { return "operator " + to_string(index); },
         [&]() {
@@ -485,7 +727,6 @@ ExplicitOperator TaskParser::read_axiom(
         [&]() { return "axiom " + to_string(index); },
         [&]() {
             ExplicitOperator op;
-            op.is_an_axiom = true;
             op.name = "<axiom>";
             op.cost = 0;
 
@@ -545,22 +786,26 @@ vector<ExplicitVariable> TaskParser::read_variables() {
     });
 }
 
-vector<vector<set<FactPair>>> TaskParser::read_mutexes(
+MutexIndex TaskParser::read_mutexes(
     const vector<ExplicitVariable> &variables) {
     return with_error_context("mutex section", [&]() {
-        vector<vector<set<FactPair>>> inconsistent_facts(variables.size());
-        for (size_t i = 0; i < variables.size(); ++i)
-            inconsistent_facts[i].resize(variables[i].domain_size);
+        vector<int> domain_sizes;
+        vector<int> first_fact;
+        int num_task_facts = 0;
+        for (const ExplicitVariable &var : variables) {
+            domain_sizes.push_back(var.domain_size);
+            first_fact.push_back(num_task_facts);
+            num_task_facts += var.domain_size;
+        }
+        vector<vector<int>> inconsistent_facts(num_task_facts);
 
         int num_mutex_groups = read_nat("number of mutex groups");
         lexer.confirm_end_of_line();
 
         /*
           NOTE: Mutex groups can overlap, in which case the same mutex
-          should not be represented multiple times. The current
-          representation takes care of that automatically by using sets.
-          If we ever change this representation, this is something to be
-          aware of.
+          should not be represented multiple times. We collect all mutexes
+          first and let the MutexIndex remove the duplicates.
         */
         for (int i = 0; i < num_mutex_groups; ++i) {
             with_error_context(
@@ -603,14 +848,18 @@ vector<vector<set<FactPair>>> TaskParser::read_mutexes(
                                    lead to *some* redundant mutexes, where some
                                    but not all facts talk about the same
                                    variable. */
-                                inconsistent_facts[fact1.var][fact1.value]
-                                    .insert(fact2);
+                                int fact1_number =
+                                    first_fact[fact1.var] + fact1.value;
+                                int fact2_number =
+                                    first_fact[fact2.var] + fact2.value;
+                                inconsistent_facts[fact1_number].push_back(
+                                    fact2_number);
                             }
                         }
                     }
                 });
         }
-        return inconsistent_facts;
+        return MutexIndex(domain_sizes, move(inconsistent_facts));
     });
 }
 
@@ -663,21 +912,21 @@ vector<FactPair> TaskParser::read_goal(
     });
 }
 
-vector<ExplicitOperator> TaskParser::read_actions(
+ExplicitOperatorTable TaskParser::read_actions(
     bool is_axiom, bool use_metric, const vector<ExplicitVariable> &variables) {
     return with_error_context(
         [&]() { return is_axiom ? "axiom section" : "operator section"; },
         [&]() {
             int count = read_nat("number of entries");
             lexer.confirm_end_of_line();
-            vector<ExplicitOperator> actions;
-            actions.reserve(count);
+            ExplicitOperatorTable actions;
             for (int i = 0; i < count; ++i) {
                 ExplicitOperator action =
                     is_axiom ? read_axiom(i, variables)
                              : read_operator(i, use_metric, variables);
                 actions.push_back(action);
             }
+            actions.shrink_to_fit();
             return actions;
         });
 }
@@ -689,16 +938,16 @@ shared_ptr<AbstractTask> TaskParser::read_task() {
     read_and_verify_version();
     bool use_metric = read_metric();
     vector<ExplicitVariable> variables = read_variables();
-    vector<vector<set<FactPair>>> mutexes = read_mutexes(variables);
+    MutexIndex mutexes = read_mutexes(variables);
     vector<int> initial_state_values = read_initial_state(variables);
     int num_variables = variables.size();
     for (int i = 0; i < num_variables; ++i) {
         variables[i].axiom_default_value = initial_state_values[i];
     }
     vector<FactPair> goals = read_goal(variables);
-    vector<ExplicitOperator> operators =
+    ExplicitOperatorTable operators =
         read_actions(false, use_metric, variables);
-    vector<ExplicitOperator> axioms = read_actions(true, use_metric, variables);
+    ExplicitOperatorTable axioms = read_actions(true, use_metric, variables);
     with_error_context(
         "confirm end of input", [&]() { lexer.confirm_end_of_input(); });
 
@@ -730,9 +979,8 @@ shared_ptr<AbstractTask> TaskParser::parse() {
 }
 
 RootTask::RootTask(
-    vector<ExplicitVariable> &&variables,
-    vector<vector<set<FactPair>>> &&mutexes,
-    vector<ExplicitOperator> &&operators, vector<ExplicitOperator> &&axioms,
+    vector<ExplicitVariable> &&variables, MutexIndex &&mutexes,
+    ExplicitOperatorTable &&operators, ExplicitOperatorTable &&axioms,
     vector<int> &&initial_state_values, vector<FactPair> &&goals)
     : variables(move(variables)),
       mutexes(move(mutexes)),
@@ -747,24 +995,6 @@ const ExplicitVariable &RootTask::get_variable(int var) const {
     return variables[var];
 }
 
-const ExplicitEffect &RootTask::get_effect(
-    int op_id, int effect_id, bool is_axiom) const {
-    const ExplicitOperator &op = get_operator_or_axiom(op_id, is_axiom);
-    assert(utils::in_bounds(effect_id, op.effects));
-    return op.effects[effect_id];
-}
-
-const ExplicitOperator &RootTask::get_operator_or_axiom(
-    int index, bool is_axiom) const {
-    if (is_axiom) {
-        assert(utils::in_bounds(index, axioms));
-        return axioms[index];
-    } else {
-        assert(utils::in_bounds(index, operators));
-        return operators[index];
-    }
-}
-
 int RootTask::get_num_variables() const {
     return variables.size();
 }
@@ -796,17 +1026,19 @@ bool RootTask::are_facts_mutex(
         // Same variable: mutex iff different value.
         return fact1.value != fact2.value;
     }
-    assert(utils::in_bounds(fact1.var, mutexes));
-    assert(utils::in_bounds(fact1.value, mutexes[fact1.var]));
-    return bool(mutexes[fact1.var][fact1.value].count(fact2));
+    return mutexes.are_mutex(fact1, fact2);
+}
+
+vector<vector<FactPair>> RootTask::get_mutexes_by_fact() const {
+    return mutexes.get_mutexes_by_fact();
 }
 
 int RootTask::get_operator_cost(int index, bool is_axiom) const {
-    return get_operator_or_axiom(index, is_axiom).cost;
+    return get_operators_or_axioms(is_axiom).get_cost(index);
 }
 
 string RootTask::get_operator_name(int index, bool is_axiom) const {
-    return get_operator_or_axiom(index, is_axiom).name;
+    return get_operators_or_axioms(is_axiom).get_name(index);
 }
 
 int RootTask::get_num_operators() const {
@@ -814,35 +1046,34 @@ int RootTask::get_num_operators() const {
 }
 
 int RootTask::get_num_operator_preconditions(int index, bool is_axiom) const {
-    return get_operator_or_axiom(index, is_axiom).preconditions.size();
+    return get_operators_or_axioms(is_axiom).get_num_preconditions(index);
 }
 
 FactPair RootTask::get_operator_precondition(
     int op_index, int fact_index, bool is_axiom) const {
-    const ExplicitOperator &op = get_operator_or_axiom(op_index, is_axiom);
-    assert(utils::in_bounds(fact_index, op.preconditions));
-    return op.preconditions[fact_index];
+    return get_operators_or_axioms(is_axiom).get_precondition(
+        op_index, fact_index);
 }
 
 int RootTask::get_num_operator_effects(int op_index, bool is_axiom) const {
-    return get_operator_or_axiom(op_index, is_axiom).effects.size();
+    return get_operators_or_axioms(is_axiom).get_num_effects(op_index);
 }
 
 int RootTask::get_num_operator_effect_conditions(
     int op_index, int eff_index, bool is_axiom) const {
-    return get_effect(op_index, eff_index, is_axiom).conditions.size();
+    return get_operators_or_axioms(is_axiom).get_num_effect_conditions(
+        op_index, eff_index);
 }
 
 FactPair RootTask::get_operator_effect_condition(
     int op_index, int eff_index, int cond_index, bool is_axiom) const {
-    const ExplicitEffect &effect = get_effect(op_index, eff_index, is_axiom);
-    assert(utils::in_bounds(cond_index, effect.conditions));
-    return effect.conditions[cond_index];
+    return get_operators_or_axioms(is_axiom).get_effect_condition(
+        op_index, eff_index, cond_index);
 }
 
 FactPair RootTask::get_operator_effect(
     int op_index, int eff_index, bool is_axiom) const {
-    return get_effect(op_index, eff_index, is_axiom).fact;
+    return get_operators_or_axioms(is_axiom).get_effect(op_index, eff_index);
 }
 
 int RootTask::convert_operator_index(
@@ -884,4 +1115,32 @@ void read_root_task(istream &in) {
     TaskParser parser(move(lexer));
     g_root_task = parser.parse();
 }
+
+void read_binary_root_task(const string &filename) {
+    assert(!g_root_task);
+    g_root_task = read_binary_task(filename);
+}
+
+void convert_root_task_to_binary(istream &in, const string &filename) {
+    utils::Timer timer;
+    int peak_memory_before = utils::get_peak_memory_in_kb();
+    read_root_task(in);
+    utils::g_log << "Time for reading the text task: " << timer.reset()
+                 << endl
+                 << "Peak memory difference for reading the text task: "
+                 << utils::get_peak_memory_in_kb() - peak_memory_before
+                 << " KB" << endl;
+
+    const RootTask &root_task = static_cast<const RootTask &>(*g_root_task);
+    write_binary_task(root_task, root_task.get_mutexes_by_fact(), filename);
+    utils::g_log << "Time for writing the binary task: " << timer.reset()
+                 << endl;
+
+    shared_ptr<AbstractTask> binary_task = read_binary_task(filename);
+    utils::g_log << "Time for reading the binary task: " << timer.reset()
+                 << endl;
+
+    verify_tasks_are_equal(root_task, *binary_task);
+    utils::g_log << "Binary task matches text task." << endl;
+}
 }
@@ -6,5 +6,16 @@
 namespace tasks {
 extern std::shared_ptr<AbstractTask> g_root_task;
 extern void read_root_task(std::istream &in);
+/*
+  Read the root task from a file in the binary task format (see
+  binary_root_task.h).
+*/
+extern void read_binary_root_task(const std::string &filename);
+/*
+  Read the root task from the text input, write it to a file in the binary
+  task format and report how long reading both formats takes.
+*/
+extern void convert_root_task_to_binary(
+    std::istream &in, const std::string &filename);
 }
 #endif
@@ -166,6 +166,29 @@ public:
         }
     }
 
+    /*
+      Feed a sequence of values. This is equivalent to calling feed() for each
+      value, but processes full triples of values without branching on
+      pending_values. If num_values is a compile-time constant, the compiler
+      can unroll the whole computation.
+    */
+    void feed_values(const std::uint32_t *values, std::size_t num_values) {
+        assert(pending_values != -1);
+        std::size_t i = 0;
+        while (i < num_values && pending_values != 3) {
+            feed(values[i++]);
+        }
+        for (; i + 3 <= num_values; i += 3) {
+            mix();
+            a += values[i];
+            b += values[i + 1];
+            c += values[i + 2];
+        }
+        while (i < num_values) {
+            feed(values[i++]);
+        }
+    }
+
     /*
       After calling this method, it is illegal to use the HashState object
       further, i.e., make further calls to feed, get_hash32 or get_hash64. We
@@ -0,0 +1,68 @@
+#include "memory_mapped_file.h"
+
+#include "exceptions.h"
+#include "system.h"
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+using namespace std;
+
+namespace utils {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+MemoryMappedFile::MemoryMappedFile(const string &filename)
+    : data(nullptr), size(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw Exception("Could not open file '" + filename + "'.");
+    }
+    struct stat file_status;
+    if (fstat(fd, &file_status) == -1) {
+        close(fd);
+        throw Exception("Could not determine size of file '" + filename + "'.");
+    }
+    size = file_status.st_size;
+    // Mapping an empty file fails, but there is nothing to map anyway.
+    if (size > 0) {
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            throw Exception("Could not map file '" + filename + "'.");
+        }
+        data = static_cast<const char *>(address);
+    }
+    // The mapping stays valid after closing the file descriptor.
+    close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (data) {
+        munmap(const_cast<char *>(data), size);
+    }
+}
+#else
+MemoryMappedFile::MemoryMappedFile(const string &filename)
+    : data(nullptr), size(0) {
+    ifstream file(filename, ios::binary);
+    if (!file) {
+        throw Exception("Could not open file '" + filename + "'.");
+    }
+    buffer.assign(
+        istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    if (file.bad()) {
+        throw Exception("Could not read file '" + filename + "'.");
+    }
+    data = buffer.data();
+    size = buffer.size();
+}
+
+MemoryMappedFile::~MemoryMappedFile() = default;
+#endif
+}
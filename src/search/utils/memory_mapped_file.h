@@ -0,0 +1,42 @@
+#ifndef UTILS_MEMORY_MAPPED_FILE_H
+#define UTILS_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only view of the contents of a file.
+
+  On Linux and macOS, the file is mapped into memory, so its pages are only
+  loaded when they are accessed and can be shared between processes that
+  use the same file. On other systems, we read the whole file into memory
+  instead.
+
+  The constructor throws a utils::Exception if the file cannot be read.
+*/
+class MemoryMappedFile {
+    const char *data;
+    std::size_t size;
+    // Only used if the file is read instead of mapped.
+    std::vector<char> buffer;
+
+public:
+    explicit MemoryMappedFile(const std::string &filename);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+};
+}
+
+#endif
@@ -65,6 +65,13 @@ NO_RETURN extern void exit_with(ExitCode returncode);
 NO_RETURN extern void exit_with_reentrant(ExitCode returncode);
 
 int get_peak_memory_in_kb();
+/*
+  Return the physical memory currently used by the process (its resident
+  set size), or -1 on error. Unlike the address space measured by
+  get_peak_memory_in_kb(), it shrinks when memory is given back to the
+  operating system, but it does not include memory that is swapped out.
+*/
+int get_resident_memory_in_kb();
 const char *get_exit_code_message_reentrant(ExitCode exitcode);
 bool is_exit_code_error_reentrant(ExitCode exitcode);
 void register_event_handlers();
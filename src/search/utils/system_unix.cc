@@ -179,34 +179,15 @@ static void signal_handler(int signal_number) {
     raise(signal_number);
 }
 
-/*
-  NOTE: we have two variants of obtaining peak memory information.
-        get_peak_memory_in_kb() is used during the regular execution.
-        print_peak_memory_in_kb_reentrant() is used in signal handlers.
-        The latter is slower but guarantees reentrancy.
-*/
-int get_peak_memory_in_kb() {
-    // On error, produces a warning on cerr and returns -1.
+#if OPERATING_SYSTEM == LINUX
+static int read_memory_from_proc_status(const string &key) {
     int memory_in_kb = -1;
-
-#if OPERATING_SYSTEM == OSX
-    // Based on http://stackoverflow.com/questions/63166
-    task_basic_info t_info;
-    mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
-
-    if (task_info(
-            mach_task_self(), TASK_BASIC_INFO,
-            reinterpret_cast<task_info_t>(&t_info),
-            &t_info_count) == KERN_SUCCESS) {
-        memory_in_kb = t_info.virtual_size / 1024;
-    }
-#else
     ifstream procfile;
     procfile.open("/proc/self/status");
     string word;
     while (procfile.good()) {
         procfile >> word;
-        if (word == "VmPeak:") {
+        if (word == key) {
             procfile >> memory_in_kb;
             break;
         }
@@ -215,6 +196,51 @@ int get_peak_memory_in_kb() {
     }
     if (procfile.fail())
         memory_in_kb = -1;
+    return memory_in_kb;
+}
+#endif
+
+#if OPERATING_SYSTEM == OSX
+static int get_resident_size_in_kb() {
+    task_basic_info t_info;
+    mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
+
+    if (task_info(
+            mach_task_self(), TASK_BASIC_INFO,
+            reinterpret_cast<task_info_t>(&t_info),
+            &t_info_count) == KERN_SUCCESS) {
+        return t_info.resident_size / 1024;
+    }
+    return -1;
+}
+
+static int get_virtual_size_in_kb() {
+    // Based on http://stackoverflow.com/questions/63166
+    task_basic_info t_info;
+    mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
+
+    if (task_info(
+            mach_task_self(), TASK_BASIC_INFO,
+            reinterpret_cast<task_info_t>(&t_info),
+            &t_info_count) == KERN_SUCCESS) {
+        return t_info.virtual_size / 1024;
+    }
+    return -1;
+}
+#endif
+
+/*
+  NOTE: we have two variants of obtaining peak memory information.
+        get_peak_memory_in_kb() is used during the regular execution.
+        print_peak_memory_in_kb_reentrant() is used in signal handlers.
+        The latter is slower but guarantees reentrancy.
+*/
+int get_peak_memory_in_kb() {
+    // On error, produces a warning on cerr and returns -1.
+#if OPERATING_SYSTEM == OSX
+    int memory_in_kb = get_virtual_size_in_kb();
+#else
+    int memory_in_kb = read_memory_from_proc_status("VmPeak:");
 #endif
 
     if (memory_in_kb == -1)
@@ -222,6 +248,19 @@ int get_peak_memory_in_kb() {
     return memory_in_kb;
 }
 
+int get_resident_memory_in_kb() {
+    // On error, produces a warning on cerr and returns -1.
+#if OPERATING_SYSTEM == OSX
+    int memory_in_kb = get_resident_size_in_kb();
+#else
+    int memory_in_kb = read_memory_from_proc_status("VmRSS:");
+#endif
+
+    if (memory_in_kb == -1)
+        cerr << "warning: could not determine current memory" << endl;
+    return memory_in_kb;
+}
+
 void register_event_handlers() {
     // Terminate when running out of memory.
     set_new_handler(out_of_memory_handler);
@@ -0,0 +1,102 @@
+#include "thread_pool.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace utils {
+ThreadPool::ThreadPool(int num_threads)
+    : current_task(nullptr),
+      num_tasks(0),
+      next_task(0),
+      num_finished_tasks(0),
+      generation(0),
+      shutting_down(false) {
+    assert(num_threads >= 1);
+    workers.reserve(num_threads - 1);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        workers.emplace_back(&ThreadPool::worker_loop, this, thread_id);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(task_mutex);
+        shutting_down = true;
+    }
+    work_available.notify_all();
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::work_on_current_tasks(
+    unique_lock<mutex> &lock, int thread_id) {
+    assert(lock.owns_lock());
+    while (next_task < num_tasks) {
+        int task_index = next_task++;
+        const function<void(int, int)> &task = *current_task;
+        lock.unlock();
+        exception_ptr task_exception;
+        try {
+            task(task_index, thread_id);
+        } catch (...) {
+            task_exception = current_exception();
+        }
+        lock.lock();
+        if (task_exception && !exception) {
+            exception = task_exception;
+        }
+        if (++num_finished_tasks == num_tasks) {
+            work_done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::worker_loop(int thread_id) {
+    int seen_generation = 0;
+    unique_lock<mutex> lock(task_mutex);
+    while (true) {
+        work_available.wait(lock, [&]() {
+            return shutting_down || generation != seen_generation;
+        });
+        if (shutting_down) {
+            return;
+        }
+        seen_generation = generation;
+        work_on_current_tasks(lock, thread_id);
+    }
+}
+
+void ThreadPool::run(int num_tasks, const function<void(int, int)> &task) {
+    if (workers.empty()) {
+        for (int task_index = 0; task_index < num_tasks; ++task_index) {
+            task(task_index, 0);
+        }
+        return;
+    }
+
+    unique_lock<mutex> lock(task_mutex);
+    assert(!current_task);
+    current_task = &task;
+    this->num_tasks = num_tasks;
+    next_task = 0;
+    num_finished_tasks = 0;
+    exception = nullptr;
+    ++generation;
+    work_available.notify_all();
+
+    work_on_current_tasks(lock, 0);
+    work_done.wait(lock, [&]() {
+        return num_finished_tasks == this->num_tasks;
+    });
+    current_task = nullptr;
+    exception_ptr task_exception = exception;
+    exception = nullptr;
+    lock.unlock();
+
+    if (task_exception) {
+        rethrow_exception(task_exception);
+    }
+}
+}
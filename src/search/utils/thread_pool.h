@@ -0,0 +1,65 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+/*
+  Fixed-size pool of worker threads for data-parallel loops.
+
+  run(num_tasks, task) calls task(task_index, thread_id) once for every task
+  index in [0, num_tasks) and returns when all calls have finished. The calling
+  thread takes part in the computation and always has thread ID 0, the worker
+  threads have IDs 1, ..., get_num_threads() - 1. Callers can use the thread ID
+  to index thread-local data (e.g. one evaluator instance per thread). Task
+  indices are distributed dynamically, so the assignment of tasks to threads
+  is not deterministic.
+
+  If a task throws an exception, the remaining tasks are still executed and
+  the first exception is rethrown in the calling thread once all tasks have
+  finished. This way, ExitExceptions raised in worker threads terminate the
+  planner gracefully.
+
+  A pool with one thread does not start any worker threads and simply runs all
+  tasks in the calling thread. run() must not be called concurrently or
+  recursively.
+*/
+class ThreadPool {
+    std::vector<std::thread> workers;
+
+    std::mutex task_mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_done;
+
+    // The following members are protected by task_mutex.
+    const std::function<void(int, int)> *current_task;
+    int num_tasks;
+    int next_task;
+    int num_finished_tasks;
+    int generation;
+    bool shutting_down;
+    std::exception_ptr exception;
+
+    void work_on_current_tasks(
+        std::unique_lock<std::mutex> &lock, int thread_id);
+    void worker_loop(int thread_id);
+public:
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int get_num_threads() const {
+        return workers.size() + 1;
+    }
+
+    void run(int num_tasks, const std::function<void(int, int)> &task);
+};
+}
+
+#endif